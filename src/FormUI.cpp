@@ -3,12 +3,15 @@
 namespace FormUI {
     static UIManager uiManager;
     static std::shared_ptr<UIPopup> internalPopup;
+    static UIFrameClock frameClock;
+    static std::function<void(float)> fixedUpdate;
 
     void Init(TTF_Font* defaultFont) {
         if (defaultFont) {
             UIConfig::setDefaultFont(defaultFont);
         }
         uiManager.initCursors();
+        frameClock.reset();
     }
 
     void Shutdown() {
@@ -17,66 +20,78 @@ namespace FormUI {
 
     std::shared_ptr<UIButton> Button(const std::string& label, int x, int y, int w, int h, std::function<void()> onClick, TTF_Font* font) 
     {
-        auto btn = std::make_shared<UIButton>(label, x, y, w, h, font);
+        auto btn = uiManager.create<UIButton>(label, x, y, w, h, font);
         if (onClick) btn->setOnClick(onClick);
         uiManager.addElement(btn);
         return btn;
     }
 
     std::shared_ptr<UICheckbox> Checkbox(const std::string& label, int x, int y, int w, int h, bool& bind, TTF_Font* font) {
-        auto box = std::make_shared<UICheckbox>(label, x, y, w, h, bind, font);
+        auto box = uiManager.create<UICheckbox>(label, x, y, w, h, bind, font);
         uiManager.addElement(box);
         return box;
     }
     
     std::shared_ptr<UILabel> Label(const std::string& text, int x, int y, int w, int h, TTF_Font* font) {
-        auto label = std::make_shared<UILabel>(text, x, y, w, h, font);
+        auto label = uiManager.create<UILabel>(text, x, y, w, h, font);
         uiManager.addElement(label);
         return label;
     }
 
     std::shared_ptr<UISlider> Slider(const std::string& label, int x, int y, int w, int h, float& bind, float min, float max) {
-        auto slider = std::make_shared<UISlider>(label, x, y, w, h, bind, min, max);
+        auto slider = uiManager.create<UISlider>(label, x, y, w, h, bind, min, max);
         uiManager.addElement(slider);
         return slider;
     }
 
     std::shared_ptr<UITextField> TextField(const std::string& label, int x, int y, int w, int h, std::string& bind, int maxLen) {
-        auto field = std::make_shared<UITextField>(label, x, y, w, h, bind, maxLen);
+        auto field = uiManager.create<UITextField>(label, x, y, w, h, bind, maxLen);
         uiManager.addElement(field);
         return field;
     }
 
     std::shared_ptr<UIComboBox> ComboBox(const std::vector<std::string>& options, int x, int y, int w, int h, int& selectedIndex, TTF_Font* font) {
-        auto box = std::make_shared<UIComboBox>(x, y, w, h, options, selectedIndex);
+        auto box = uiManager.create<UIComboBox>(x, y, w, h, options, selectedIndex);
         box->setFont(font ? font : UIConfig::getDefaultFont());
         uiManager.addElement(box);
         return box;
     }
 
     std::shared_ptr<UISpinner> Spinner(int x, int y, int w, int h, int& bind, int min, int max, int step, TTF_Font* font) {
-        auto spinner = std::make_shared<UISpinner>(x, y, w, h, bind, min, max, step);
+        auto spinner = uiManager.create<UISpinner>(x, y, w, h, bind, min, max, step);
         if (font) spinner->setFont(font);
         AddElement(spinner);
         return spinner;
     }
     
     std::shared_ptr<UITextArea> TextArea(const std::string& label, int x, int y, int w, int h, std::string& bind, int maxLen) {
-        return std::make_shared<UITextArea>(label, x, y, w, h, bind, maxLen);
+        return uiManager.create<UITextArea>(label, x, y, w, h, bind, maxLen);
     }
     
 
+    void UseWidgetArena(bool on) {
+        uiManager.setUseArena(on);
+    }
+
     void AddElement(std::shared_ptr<UIElement> element) {
         uiManager.addElement(element);
     }
 
+    bool RemoveElement(const std::shared_ptr<UIElement>& element) {
+        return uiManager.removeElement(element.get());
+    }
+
     void ShowPopup(std::shared_ptr<UIPopup> popup) {
         internalPopup = popup;
         uiManager.showPopup(popup);
     }
     
     void ClosePopup() {
-        if (internalPopup) internalPopup->visible = false;
+        if (internalPopup) internalPopup->setVisible(false);
+    }
+
+    void SetPopupBackdrop(UIManager::PopupBackdrop mode, int blurRadius) {
+        uiManager.setPopupBackdrop(mode, blurRadius);
     }
 
     void HandleEvent(const SDL_Event& e) {
@@ -84,10 +99,51 @@ namespace FormUI {
     }
 
     void Update() {
-        uiManager.update(0.0f);
+        const float dt = frameClock.tick();
+        if (fixedUpdate) {
+            const float step = frameClock.fixedStep();
+            for (int n = frameClock.takeFixedSteps(); n > 0; --n) fixedUpdate(step);
+        }
+        uiManager.update(dt);
+    }
+
+    int NextTimeout() {
+        return uiManager.nextTimerTimeout();
+    }
+
+    float FrameDelta() {
+        return frameClock.delta();
+    }
+
+    const UIFrameClock::Stats& FrameStats() {
+        return frameClock.stats();
+    }
+
+    void SetMaxFrameDelta(float seconds) {
+        frameClock.setMaxDelta(seconds);
+    }
+
+    void SetFixedUpdate(float stepSeconds, std::function<void(float)> cb, int maxStepsPerFrame) {
+        if (stepSeconds <= 0.f || !cb) {
+            fixedUpdate = nullptr;
+            frameClock.setFixedStep(0.f);
+            return;
+        }
+        fixedUpdate = std::move(cb);
+        frameClock.setFixedStep(stepSeconds, maxStepsPerFrame);
+    }
+
+    float FixedUpdateAlpha() {
+        return frameClock.fixedAlpha();
+    }
+
+    void SetCulling(bool renderCulling, bool updateCulling) {
+        uiManager.setCulling(renderCulling, updateCulling);
     }
 
     void Render(SDL_Renderer* renderer) {
         uiManager.render(renderer);
+        const auto& c = uiManager.cullStats();
+        frameClock.setElementCounts(c.drawn, c.culled, c.updated, c.updateCulled);
     }
 }
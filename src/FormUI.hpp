@@ -14,12 +14,16 @@
 #include "UIComboBox.hpp"
 #include "UISpinner.hpp"
 #include "UITextArea.hpp"
+#include "UIFrameClock.hpp"
 
 
 namespace FormUI {
     // NOTE: SDLFormUI does not take ownership of the font.
     void Init(TTF_Font* defaultFont = nullptr);
     void Shutdown();
+    // Allocate widgets made by the factories below from pooled storage.
+    // Call before building the form.
+    void UseWidgetArena(bool on = true);
 
     std::shared_ptr<UIButton> Button( const std::string& label, int x, int y, int w, int h, std::function<void()> onClick = nullptr, TTF_Font* font = nullptr);
     std::shared_ptr<UICheckbox> Checkbox(const std::string& label, int x, int y, int w, int h, bool& bind, TTF_Font* font);
@@ -30,12 +34,32 @@ namespace FormUI {
     std::shared_ptr<UISpinner> Spinner(int x, int y, int w, int h, int& bind, int min = 0, int max = 100, int step = 1, TTF_Font* font = nullptr);
     std::shared_ptr<UITextArea> TextArea(const std::string& label, int x, int y, int w, int h, std::string& bind, int maxLen = 512);
     void AddElement(std::shared_ptr<UIElement> element);
+    bool RemoveElement(const std::shared_ptr<UIElement>& element);
     void ShowPopup(std::shared_ptr<UIPopup> popup);
     void ClosePopup();
+    // Default: the scene keeps rendering, dimmed, under the popup. Snapshot
+    // and Blurred capture it once per popup instead (see invalidateBackdrop).
+    void SetPopupBackdrop(UIManager::PopupBackdrop mode, int blurRadius = 6);
 
 
 
     void HandleEvent(const SDL_Event& e);
     void Update();
+    // Milliseconds until the next widget timer (caret blink, auto-repeat, ...)
+    // is due, or -1 if none. Pass to SDL_WaitEventTimeout to idle between frames.
+    int NextTimeout();
+
+    // Update() ticks a high-resolution clock and passes the real frame delta
+    // to every widget.
+    float FrameDelta();
+    const UIFrameClock::Stats& FrameStats();
+    void SetMaxFrameDelta(float seconds);
+    // Runs cb(stepSeconds) zero or more times per Update() at a fixed rate,
+    // before widgets are updated. Pass stepSeconds <= 0 or a null cb to disable.
+    void SetFixedUpdate(float stepSeconds, std::function<void(float)> cb, int maxStepsPerFrame = 5);
+    float FixedUpdateAlpha();
+    // Skip elements outside the viewport when rendering (on by default) and,
+    // optionally, when updating. Counts show up in FrameStats().
+    void SetCulling(bool renderCulling, bool updateCulling = false);
     void Render(SDL_Renderer* renderer);
 }
@@ -11,7 +11,9 @@ void UIButton::setOnClick(std::function<void()> callback) {
 }
 
 void UIButton::setText(const std::string& newText) {
+    if (label == newText) return;
     label = newText;
+    markDirty();
 }
 
 const std::string& UIButton::getText() const {
@@ -23,6 +25,8 @@ void UIButton::handleEvent(const SDL_Event& e) {
     if (e.type == SDL_USEREVENT) {
         if (e.user.code == 0xF001) { focused = true;  return; }
         if (e.user.code == 0xF002) { focused = false; return; }
+        if (e.user.code == 0xF003) { hovered = enabled; return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
     }
     if (!enabled) return;
 
@@ -56,18 +60,14 @@ void UIButton::handleEvent(const SDL_Event& e) {
     }
 }
 
-void UIButton::update(float) {
-    if (!enabled) { hovered = false; pressed = false; return; }
-    int mx, my; SDL_GetMouseState(&mx, &my);
-    SDL_Point mousePoint = { mx, my };
-    hovered = SDL_PointInRect(&mousePoint, &bounds);
+void UIButton::enabledChanged() {
+    if (!enabled) { hovered = false; pressed = false; }
 }
 
 
 void UIButton::render(SDL_Renderer* renderer) {
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeButtonStyle(th, ds);
+    const auto st = resolvedStyle<UIButtonStyle>();
 
     SDL_Color baseBg     = customBgColor   ? *customBgColor   : th.backgroundColor;
     SDL_Color baseText   = customTextColor ? *customTextColor : st.text;
@@ -141,6 +141,7 @@ void UIButton::render(SDL_Renderer* renderer) {
 
 void UIButton::setFont(TTF_Font* f) {
     font = f;
+    markDirty();
 }
 
 bool UIButton::isHovered() const {
@@ -149,15 +150,18 @@ bool UIButton::isHovered() const {
 
 UIButton* UIButton::setTextColor(SDL_Color c) {
     customTextColor = c;
+    markDirty();
     return this;
 }
 
 UIButton* UIButton::setBackgroundColor(SDL_Color c) {
     customBgColor = c;
+    markDirty();
     return this;
 }
 
 UIButton* UIButton::setBorderColor(SDL_Color c) {
     customBorderColor = c;
+    markDirty();
     return this;
 }
\ No newline at end of file
@@ -16,7 +16,8 @@ public:
     void setText(const std::string& newText);
     const std::string& getText() const;
     void handleEvent(const SDL_Event& e) override;
-    void update(float dt) override;
+    void update(float) override {}
+    bool wantsFrameUpdate() const override { return false; }
     void render(SDL_Renderer* renderer) override;
     bool isFocusable() const override { return focusable; }
     void setFont(TTF_Font* f);
@@ -24,11 +25,14 @@ public:
     UIButton* setTextColor(SDL_Color c);
     UIButton* setBackgroundColor(SDL_Color c);
     UIButton* setBorderColor(SDL_Color c);
-    UIButton* setCornerRadius(int r) { cornerRadius = (r < 0 ? 0 : r); return this; }
-    UIButton* setBorderThickness(int px) { borderPx = (px < 0 ? 0 : px); return this; }
+    UIButton* setCornerRadius(int r) { cornerRadius = (r < 0 ? 0 : r); markDirty(); return this; }
+    UIButton* setBorderThickness(int px) { borderPx = (px < 0 ? 0 : px); markDirty(); return this; }
     UIButton* setFocusable(bool f) { focusable = f; return this; }
     bool isFocused() const { return focused; }
 
+protected:
+    void enabledChanged() override;
+
 private:
     std::string label;
     std::function<void()> onClick;
@@ -0,0 +1,218 @@
+#include "UIChart.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define UICHART_SSE2 1
+#endif
+
+static constexpr size_t DEFAULT_WINDOW = 1 << 16;
+
+// Min and max of p[0..n), n > 0.
+static void minMaxSpan(const float* p, size_t n, float& outMin, float& outMax) {
+    size_t i = 0;
+    float mn = p[0], mx = p[0];
+#if UICHART_SSE2
+    if (n >= 8) {
+        __m128 mn0 = _mm_loadu_ps(p), mx0 = mn0;
+        __m128 mn1 = _mm_loadu_ps(p + 4), mx1 = mn1;
+        for (i = 8; i + 8 <= n; i += 8) {
+            const __m128 a = _mm_loadu_ps(p + i), b = _mm_loadu_ps(p + i + 4);
+            mn0 = _mm_min_ps(mn0, a); mx0 = _mm_max_ps(mx0, a);
+            mn1 = _mm_min_ps(mn1, b); mx1 = _mm_max_ps(mx1, b);
+        }
+        alignas(16) float lmn[4], lmx[4];
+        _mm_store_ps(lmn, _mm_min_ps(mn0, mn1));
+        _mm_store_ps(lmx, _mm_max_ps(mx0, mx1));
+        mn = std::min(std::min(lmn[0], lmn[1]), std::min(lmn[2], lmn[3]));
+        mx = std::max(std::max(lmx[0], lmx[1]), std::max(lmx[2], lmx[3]));
+    }
+#else
+    // Independent lanes so the compiler can vectorize the loop.
+    if (n >= 4) {
+        float m[4] = { p[0], p[1], p[2], p[3] }, M[4] = { p[0], p[1], p[2], p[3] };
+        for (i = 4; i + 4 <= n; i += 4)
+            for (int k = 0; k < 4; ++k) { m[k] = std::min(m[k], p[i + k]); M[k] = std::max(M[k], p[i + k]); }
+        mn = std::min(std::min(m[0], m[1]), std::min(m[2], m[3]));
+        mx = std::max(std::max(M[0], M[1]), std::max(M[2], M[3]));
+    }
+#endif
+    for (; i < n; ++i) { mn = std::min(mn, p[i]); mx = std::max(mx, p[i]); }
+    outMin = mn;
+    outMax = mx;
+}
+
+UIChart::UIChart(int x, int y, int w, int h) : ring(std::make_shared<UISampleRing>()) {
+    bounds = { x, y, w, h };
+    setWindow(DEFAULT_WINDOW);
+}
+
+UIChart* UIChart::setSource(std::shared_ptr<UISampleRing> r) {
+    ring = r ? std::move(r) : std::make_shared<UISampleRing>();
+    cursor = ring->written();
+    clear();
+    return this;
+}
+
+UIChart* UIChart::setWindow(size_t samples) {
+    samples = std::max<size_t>(samples, 2);
+    if (samples == windowCap) return this;
+    // Keep the newest samples that still fit.
+    const size_t keep = std::min(count, samples);
+    std::vector<float> next(samples * 2, 0.f);
+    for (size_t i = 0; i < keep; ++i) {
+        const float v = hist[head + windowCap - keep + i];
+        next[i] = next[i + samples] = v;
+    }
+    hist.swap(next);
+    windowCap = samples;
+    head = keep % samples;
+    count = keep;
+    envelopeDirty = true;
+    markDirty();
+    return this;
+}
+
+void UIChart::clear() {
+    head = count = 0;
+    envelopeDirty = true;
+    markDirty();
+}
+
+UIChart* UIChart::setRange(float mn, float mx) {
+    autoRange = !(mn < mx);
+    fixedMin = mn;
+    fixedMax = mx;
+    envelopeDirty = true;
+    markDirty();
+    return this;
+}
+
+void UIChart::update(float) {
+    incoming.clear();
+    Uint64 lost = 0;
+    cursor = ring->read(cursor, incoming, &lost);
+    dropped += lost;
+    if (incoming.empty()) return;
+
+    // Only the last windowCap samples can survive.
+    const size_t n = incoming.size();
+    const size_t skip = n > windowCap ? n - windowCap : 0;
+    for (size_t i = skip; i < n; ++i) {
+        hist[head] = hist[head + windowCap] = incoming[i];
+        if (++head == windowCap) head = 0;
+    }
+    count = std::min(windowCap, count + (n - skip));
+    envelopeDirty = true;
+    markDirty();
+}
+
+// Column c covers samples [c*n/W, (c+1)*n/W) of the visible span. With
+// fewer samples than columns every sample gets its own column.
+void UIChart::rebuildEnvelope_(int columns) {
+    envelopeDirty = false;
+    envelopeW = columns;
+    colMin.clear();
+    colMax.clear();
+    if (count == 0 || columns <= 0) return;
+
+    const float* span = hist.data() + head + windowCap - count;
+    const size_t cols = std::min((size_t)columns, count);
+    colMin.resize(cols);
+    colMax.resize(cols);
+    for (size_t c = 0; c < cols; ++c) {
+        const size_t a = c * count / cols, b = std::max(a + 1, (c + 1) * count / cols);
+        minMaxSpan(span + a, b - a, colMin[c], colMax[c]);
+    }
+
+    if (autoRange) {
+        float mn, mx;
+        minMaxSpan(colMin.data(), cols, mn, mx);
+        lo = mn;
+        minMaxSpan(colMax.data(), cols, mn, mx);
+        hi = mx;
+        if (!(hi > lo)) { lo -= 0.5f; hi += 0.5f; }
+    } else {
+        lo = fixedMin;
+        hi = fixedMax;
+    }
+}
+
+void UIChart::render(SDL_Renderer* renderer) {
+    if (!visible) return;
+    const auto st = resolvedStyle<UIChartStyle>();
+
+    if (st.borderPx > 0) {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.border);
+        UIHelpers::FillRoundedRect(renderer, bounds.x + st.borderPx, bounds.y + st.borderPx,
+                                   bounds.w - 2*st.borderPx, bounds.h - 2*st.borderPx,
+                                   std::max(0, st.radius - st.borderPx), st.track);
+    } else {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.track);
+    }
+
+    const int inset = st.borderPx + st.pad;
+    const SDL_Rect plot{ bounds.x + inset, bounds.y + inset,
+                         std::max(0, bounds.w - 2*inset), std::max(0, bounds.h - 2*inset) };
+    if (plot.w <= 1 || plot.h <= 1) return;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    if (gridLines > 0) {
+        SDL_SetRenderDrawColor(renderer, st.grid.r, st.grid.g, st.grid.b, st.grid.a);
+        for (int i = 1; i <= gridLines; ++i) {
+            const int y = plot.y + plot.h * i / (gridLines + 1);
+            SDL_RenderDrawLine(renderer, plot.x, y, plot.x + plot.w - 1, y);
+        }
+    }
+
+    if (envelopeDirty || envelopeW != plot.w) rebuildEnvelope_(plot.w);
+    const size_t cols = colMin.size();
+    if (cols == 0) return;
+
+    const float sy = (plot.h - 1) / (hi - lo);
+    const float bottom = (float)(plot.y + plot.h - 1);
+    const float dx = cols > 1 ? (float)(plot.w - 1) / (float)(cols - 1) : 0.f;
+    auto yOf = [&](float v) { return std::clamp(bottom - (v - lo) * sy, (float)plot.y, bottom); };
+
+    SDL_Rect prevClip;
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer);
+    SDL_RenderGetClipRect(renderer, &prevClip);
+    SDL_Rect clip = plot;
+    if (hadClip) SDL_IntersectRect(&prevClip, &plot, &clip);
+    SDL_RenderSetClipRect(renderer, &clip);
+
+    // Area under the curve: from each column's max down to the plot bottom,
+    // one quad per column step.
+    if (filled && cols > 1) {
+        verts.resize(cols * 2);
+        indices.resize((cols - 1) * 6);
+        for (size_t c = 0; c < cols; ++c) {
+            const float x = plot.x + c * dx;
+            verts[2*c]     = { { x, yOf(colMax[c]) }, st.fill, { 0.f, 0.f } };
+            verts[2*c + 1] = { { x, bottom + 1.f },   st.fill, { 0.f, 0.f } };
+        }
+        for (size_t c = 0; c + 1 < cols; ++c) {
+            const int a = (int)(2*c);
+            int* q = &indices[c * 6];
+            q[0] = a; q[1] = a + 1; q[2] = a + 2;
+            q[3] = a + 2; q[4] = a + 1; q[5] = a + 3;
+        }
+        SDL_RenderGeometry(renderer, nullptr, verts.data(), (int)verts.size(), indices.data(), (int)indices.size());
+    }
+
+    // Zig-zag through the envelope: down one column and up the next, so
+    // the single polyline covers every column's full extent.
+    points.resize(cols * 2);
+    for (size_t c = 0; c < cols; ++c) {
+        const float x = plot.x + c * dx;
+        const float a = yOf(colMin[c]), b = yOf(colMax[c]);
+        points[2*c]     = { x, (c & 1) ? b : a };
+        points[2*c + 1] = { x, (c & 1) ? a : b };
+    }
+    SDL_Color line = st.line;
+    if (!enabled) line.a = 140;
+    SDL_SetRenderDrawColor(renderer, line.r, line.g, line.b, line.a);
+    SDL_RenderDrawLinesF(renderer, points.data(), (int)points.size());
+
+    SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UISampleRing.hpp"
+#include <memory>
+#include <vector>
+
+// Streaming line chart / sparkline. Samples arrive through a UISampleRing
+// (fed from any one thread) and are drained into a history window in
+// update(). The window is reduced to one min/max pair per pixel column,
+// redone in O(window) only on frames that brought new samples or a resize;
+// drawing is O(width) whatever the window size, with the envelope sent as
+// one geometry batch plus one line batch.
+class UIChart : public UIElement {
+public:
+    UIChart(int x, int y, int w, int h);
+
+    // Shared with the producer. Without one, push() feeds a private ring.
+    UIChart* setSource(std::shared_ptr<UISampleRing> ring);
+    const std::shared_ptr<UISampleRing>& source() const { return ring; }
+    void push(float v) { ring->push(v); }
+
+    // Number of most recent samples shown across the width.
+    UIChart* setWindow(size_t samples);
+    size_t window() const { return windowCap; }
+    void clear();
+
+    // Fixed vertical range; mn >= mx switches back to auto-ranging.
+    UIChart* setRange(float mn, float mx);
+    UIChart* setFilled(bool on) { filled = on; markDirty(); return this; }
+    UIChart* setGridLines(int n) { gridLines = n < 0 ? 0 : n; markDirty(); return this; }
+
+    size_t sampleCount() const { return count; }
+    Uint64 droppedSamples() const { return dropped; }
+
+    void handleEvent(const SDL_Event&) override {}
+    void update(float dt) override;
+    void render(SDL_Renderer* renderer) override;
+
+private:
+    std::shared_ptr<UISampleRing> ring;
+    Uint64 cursor = 0;
+    Uint64 dropped = 0;
+    std::vector<float> incoming;
+
+    // Every sample is stored twice, at i and i + windowCap, so the last n
+    // samples are always one contiguous span.
+    std::vector<float> hist;
+    size_t windowCap = 0;
+    size_t head = 0;
+    size_t count = 0;
+
+    float fixedMin = 0.f, fixedMax = 0.f;
+    bool  autoRange = true;
+    bool  filled = true;
+    int   gridLines = 3;
+
+    // Per-column envelope, rebuilt when samples or the plot width change.
+    std::vector<float> colMin, colMax;
+    bool envelopeDirty = true;
+    int  envelopeW = 0;
+    float lo = 0.f, hi = 1.f;
+
+    std::vector<SDL_Vertex> verts;
+    std::vector<int> indices;
+    std::vector<SDL_FPoint> points;
+
+    void rebuildEnvelope_(int columns);
+};
@@ -8,9 +8,14 @@ UICheckbox::UICheckbox(const std::string& label, int x, int y, int w, int h, boo
 
 void UICheckbox::setFont(TTF_Font* f) {
     font = f;
+    markDirty();
 }
 
 void UICheckbox::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
+    }
     if (!enabled) return;
 
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
@@ -46,16 +51,16 @@ bool UICheckbox::isHovered() const {
 }
 
 void UICheckbox::update(float) {
-    int mx, my;
-    SDL_GetMouseState(&mx, &my);
-    SDL_Point mousePoint = { mx, my };
-    hovered = SDL_PointInRect(&mousePoint, &bounds);
+    // The bound value changes behind our back; report it to cached layers.
+    if (linkedValue.get() != seenValue) {
+        seenValue = linkedValue.get();
+        markDirty();
+    }
 }
 
 void UICheckbox::render(SDL_Renderer* renderer) {
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeCheckboxStyle(th, ds);
+    const auto st = resolvedStyle<UICheckboxStyle>();
 
     TTF_Font* activeFont = font ? font : (th.font ? th.font : UIConfig::getDefaultFont());
     if (!activeFont) return;
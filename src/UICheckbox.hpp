@@ -14,11 +14,11 @@ public:
     UICheckbox(const std::string& label, int x, int y, int w, int h, bool& bind, TTF_Font* f);
 
     void setFont(TTF_Font* f);
-     UICheckbox* setTextColor(SDL_Color c)    { customTextColor   = c; hasCustomTextColor   = true; return this; }
-    UICheckbox* setCheckedColor(SDL_Color c) { customCheckedColor= c; hasCustomCheckedColor= true; return this; }
-    UICheckbox* setBoxBackground(SDL_Color c){ customBoxBgColor   = c; hasCustomBoxBgColor   = true; return this; }
-    UICheckbox* setBorderColor(SDL_Color c)   { customBorderColor = c; hasCustomBorderColor = true; return this; }
-    UICheckbox* setBorderThickness(int px) { borderPx = std::max(0, px); return this; }
+    UICheckbox* setTextColor(SDL_Color c)    { customTextColor   = c; hasCustomTextColor   = true; markDirty(); return this; }
+    UICheckbox* setCheckedColor(SDL_Color c) { customCheckedColor= c; hasCustomCheckedColor= true; markDirty(); return this; }
+    UICheckbox* setBoxBackground(SDL_Color c){ customBoxBgColor   = c; hasCustomBoxBgColor   = true; markDirty(); return this; }
+    UICheckbox* setBorderColor(SDL_Color c)   { customBorderColor = c; hasCustomBorderColor = true; markDirty(); return this; }
+    UICheckbox* setBorderThickness(int px) { borderPx = std::max(0, px); markDirty(); return this; }
 
     bool isFocusable() const override { return focusable; }
 
@@ -33,6 +33,7 @@ private:
     bool focused = false;
     bool focusable = true;
     std::reference_wrapper<bool> linkedValue;
+    bool seenValue = false;
     TTF_Font* font = nullptr;
     SDL_Color customTextColor{};    bool hasCustomTextColor    = false;
     SDL_Color customCheckedColor{}; bool hasCustomCheckedColor = false;
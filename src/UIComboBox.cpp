@@ -1,4 +1,10 @@
 #include "UIComboBox.hpp"
+#include <cctype>
+
+static constexpr int    SCROLLBAR_PX   = 8;
+static constexpr int    MIN_THUMB_PX   = 16;
+static constexpr int    WHEEL_ROWS     = 3;
+static constexpr Uint32 TYPE_AHEAD_MS  = 1000;
 
 UIComboBox::UIComboBox(int x, int y, int w, int h, const std::vector<std::string>& options, int& selectedIndex)
     : options(options), selectedIndex(selectedIndex)
@@ -8,6 +14,7 @@ UIComboBox::UIComboBox(int x, int y, int w, int h, const std::vector<std::string
 
 void UIComboBox::setFont(TTF_Font* f) {
     font = f;
+    markDirty();
 }
 
 void UIComboBox::setOnSelect(std::function<void(int)> callback) {
@@ -34,20 +41,32 @@ const SDL_Rect& UIComboBox::getBounds() const {
     return bounds;
 }
 
+// The menu holds at most maxVisibleItems rows and shrinks further to fit
+// whichever side of the field has more room.
 void UIComboBox::updateDropdownRect(SDL_Renderer* renderer) const {
-    const int ih = bounds.h;
-    SDL_Rect menu = { bounds.x, bounds.y + bounds.h, bounds.w, ih * (int)options.size() };
-    
+    const int ih = std::max(1, bounds.h);
+    const int b = resolvedStyle<UIComboBoxStyle>().borderPx;
+    int rows = std::min((int)options.size(), maxVisibleItems);
+    SDL_Rect menu = { bounds.x, bounds.y + bounds.h, bounds.w, ih * rows + 2*b };
+
     if (renderer) {
         int windowH = 0;
         SDL_GetRendererOutputSize(renderer, nullptr, &windowH);
-        
-        bool fitsBelow = (menu.y + menu.h) <= windowH;
-        if (!fitsBelow) {
-            menu.y = bounds.y - menu.h;
+        const int below = windowH - (bounds.y + bounds.h);
+        const int above = bounds.y;
+        if (menu.h > below) {
+            if (menu.h <= above) {
+                menu.y = bounds.y - menu.h;
+            } else {
+                const bool up = above > below;
+                rows = std::max(1, std::min(rows, ((up ? above : below) - 2*b) / ih));
+                menu.h = ih * rows + 2*b;
+                if (up) menu.y = bounds.y - menu.h;
+            }
         }
     }
-    
+
+    visibleItems = rows;
     cachedDropdownRect = menu;
     dropdownPositionValid = true;
 }
@@ -56,6 +75,109 @@ SDL_Rect UIComboBox::getDropdownRect() const {
     return cachedDropdownRect;
 }
 
+SDL_Rect UIComboBox::listRect_() const {
+    const int b = resolvedStyle<UIComboBoxStyle>().borderPx;
+    const SDL_Rect m = getDropdownRect();
+    SDL_Rect r{ m.x + b, m.y + b, std::max(0, m.w - 2*b), std::max(0, m.h - 2*b) };
+    if ((int)options.size() > visibleItems) r.w = std::max(0, r.w - SCROLLBAR_PX);
+    return r;
+}
+
+SDL_Rect UIComboBox::scrollTrack_() const {
+    const SDL_Rect l = listRect_();
+    return { l.x + l.w, l.y, SCROLLBAR_PX, l.h };
+}
+
+int UIComboBox::itemAt_(int x, int y) const {
+    const SDL_Rect l = listRect_();
+    const SDL_Point p{ x, y };
+    if (!SDL_PointInRect(&p, &l)) return -1;
+    const int idx = firstVisible + (y - l.y) / std::max(1, bounds.h);
+    return idx < (int)options.size() ? idx : -1;
+}
+
+void UIComboBox::scrollTo_(int first) {
+    const int rows = visibleItems > 0 ? visibleItems : std::min((int)options.size(), maxVisibleItems);
+    firstVisible = std::clamp(first, 0, std::max(0, (int)options.size() - rows));
+}
+
+void UIComboBox::ensureVisible_(int index) {
+    if (index < 0) return;
+    const int rows = std::max(1, visibleItems > 0 ? visibleItems : std::min((int)options.size(), maxVisibleItems));
+    if (index < firstVisible) scrollTo_(index);
+    else if (index >= firstVisible + rows) scrollTo_(index - rows + 1);
+}
+
+void UIComboBox::setHot_(int index) {
+    if (options.empty()) return;
+    hoveredIndex = std::clamp(index, 0, (int)options.size() - 1);
+    ensureVisible_(hoveredIndex);
+}
+
+void UIComboBox::scrollFromTrack_(int y) {
+    const SDL_Rect track = scrollTrack_();
+    const int n = (int)options.size();
+    if (track.h <= 0 || n <= visibleItems) return;
+    const double t = std::clamp((y - track.y) / (double)track.h, 0.0, 1.0);
+    scrollTo_((int)(t * n) - visibleItems / 2);
+}
+
+void UIComboBox::commit_(int index) {
+    selectedIndex.get() = index;
+    if (onSelect) onSelect(index);
+}
+
+void UIComboBox::buildTypeIndex_() {
+    typeIndex.clear();
+    typeIndex.reserve(options.size());
+    for (int i = 0; i < (int)options.size(); ++i) {
+        std::string key = options[i];
+        for (char& c : key) c = (char)std::tolower((unsigned char)c);
+        typeIndex.emplace_back(std::move(key), i);
+    }
+    std::sort(typeIndex.begin(), typeIndex.end());
+    rankOf.assign(options.size(), 0);
+    for (int r = 0; r < (int)typeIndex.size(); ++r) rankOf[typeIndex[r].second] = r;
+    typeIndexDirty = false;
+}
+
+// Options starting with prefix form one run of the sorted index. With
+// advance set, the option after current in that run is returned.
+int UIComboBox::findPrefix_(const std::string& prefix, int current, bool advance) const {
+    auto lo = std::lower_bound(typeIndex.begin(), typeIndex.end(), prefix,
+        [](const std::pair<std::string, int>& e, const std::string& p) { return e.first < p; });
+    auto hi = std::partition_point(lo, typeIndex.end(),
+        [&](const std::pair<std::string, int>& e) { return e.first.compare(0, prefix.size(), prefix) == 0; });
+    if (lo == hi) return -1;
+    if (current >= 0 && current < (int)rankOf.size()) {
+        const auto at = typeIndex.begin() + rankOf[current];
+        if (at >= lo && at < hi) {
+            if (!advance) return current;
+            return (at + 1 < hi ? at + 1 : lo)->second;
+        }
+    }
+    return lo->second;
+}
+
+bool UIComboBox::typeAhead_(char c) {
+    if (options.empty()) return false;
+    if (typeIndexDirty) buildTypeIndex_();
+    const Uint32 now = SDL_GetTicks();
+    if (now - lastTypedAt > TYPE_AHEAD_MS) typed.clear();
+    lastTypedAt = now;
+    typed += (char)std::tolower((unsigned char)c);
+
+    const int current = expanded ? hoveredIndex : selectedIndex.get();
+    // "aaa" cycles through the options starting with 'a'.
+    const bool repeat = typed.find_first_not_of(typed[0]) == std::string::npos;
+    const int found = repeat ? findPrefix_(typed.substr(0, 1), current, true)
+                             : findPrefix_(typed, current, false);
+    if (found < 0) return true;
+    if (expanded) setHot_(found);
+    else if (found != selectedIndex.get()) commit_(found);
+    return true;
+}
+
 void UIComboBox::handleEvent(const SDL_Event& e) {
     if (e.type == SDL_USEREVENT) {
         if (e.user.code == 0xF001) { focused = true; return; }
@@ -63,11 +185,33 @@ void UIComboBox::handleEvent(const SDL_Event& e) {
             focused = false; 
             expanded = false; 
             dropdownPositionValid = false;
+            draggingScroll = false;
             return; 
         }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
     }
     if (!enabled) return;
 
+    if (e.type == SDL_MOUSEWHEEL) {
+        if (expanded) scrollTo_(firstVisible - e.wheel.y * WHEEL_ROWS);
+        return;
+    }
+
+    if (e.type == SDL_MOUSEMOTION) {
+        if (draggingScroll) { scrollFromTrack_(e.motion.y); return; }
+        if (expanded && dropdownPositionValid) {
+            const int idx = itemAt_(e.motion.x, e.motion.y);
+            if (idx >= 0) hoveredIndex = idx;
+        }
+        return;
+    }
+
+    if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
+        draggingScroll = false;
+        return;
+    }
+
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
         SDL_Point p{ e.button.x, e.button.y };
 
@@ -76,6 +220,7 @@ void UIComboBox::handleEvent(const SDL_Event& e) {
             if (expanded) {
                 const int hi = (int)options.size() - 1;
                 if (hi >= 0) hoveredIndex = std::clamp((int)selectedIndex.get(), 0, hi);
+                revealHot = true;
                 notifyExpanded = true;
             } else {
                 dropdownPositionValid = false;
@@ -84,29 +229,35 @@ void UIComboBox::handleEvent(const SDL_Event& e) {
         }
 
         if (expanded && dropdownPositionValid) {
-            SDL_Rect dropdownRect = getDropdownRect();
-            const int ih = bounds.h;
-            
-            for (int i = 0; i < (int)options.size(); ++i) {
-                SDL_Rect itemRect{ dropdownRect.x, dropdownRect.y + i * ih, dropdownRect.w, ih };
-                if (SDL_PointInRect(&p, &itemRect)) {
-                    selectedIndex.get() = i;
-                    if (onSelect) onSelect(i);
-                    expanded = false;
-                    dropdownPositionValid = false;
+            if ((int)options.size() > visibleItems) {
+                const SDL_Rect track = scrollTrack_();
+                if (SDL_PointInRect(&p, &track)) {
+                    draggingScroll = true;
+                    scrollFromTrack_(p.y);
                     return;
                 }
             }
-            
+            const int idx = itemAt_(p.x, p.y);
             expanded = false;
             dropdownPositionValid = false;
+            if (idx >= 0) commit_(idx);
         }
     }
 
     if (!focused) return;
 
     if (e.type == SDL_KEYDOWN) {
-        switch (e.key.keysym.sym) {
+        const SDL_Keycode sym = e.key.keysym.sym;
+        const bool typing = !typed.empty() && SDL_GetTicks() - lastTypedAt <= TYPE_AHEAD_MS;
+        if (sym >= 32 && sym < 127 && (sym != SDLK_SPACE || typing) &&
+            !(e.key.keysym.mod & (KMOD_CTRL | KMOD_ALT | KMOD_GUI))) {
+            typeAhead_((char)sym);
+            return;
+        }
+
+        const int last = (int)options.size() - 1;
+        const int page = std::max(1, visibleItems - 1);
+        switch (sym) {
             case SDLK_ESCAPE:
                 if (expanded) { 
                     expanded = false; 
@@ -118,70 +269,44 @@ void UIComboBox::handleEvent(const SDL_Event& e) {
             case SDLK_SPACE:
             case SDLK_RETURN:
                 if (expanded) {
-                    if (!options.empty() && hoveredIndex >= 0 && hoveredIndex < (int)options.size()) {
-                        selectedIndex.get() = hoveredIndex;
-                        if (onSelect) onSelect(hoveredIndex);
-                    }
+                    if (!options.empty() && hoveredIndex >= 0 && hoveredIndex <= last) commit_(hoveredIndex);
                     expanded = false;
                     dropdownPositionValid = false;
                 } else {
                     expanded = true;
                     notifyExpanded = true;
-                    const int hi = (int)options.size() - 1;
-                    if (hi >= 0) hoveredIndex = std::clamp((int)selectedIndex.get(), 0, hi);
+                    revealHot = true;
+                    if (last >= 0) hoveredIndex = std::clamp((int)selectedIndex.get(), 0, last);
                 }
                 return;
 
             case SDLK_UP:
-                if (!expanded) {
-                    if (!options.empty()) {
-                        expanded = true;
-                        notifyExpanded = true;
-                        const int hi = (int)options.size() - 1;
-                        hoveredIndex = std::clamp((int)selectedIndex.get(), 0, hi);
-                    }
-                    return;
-                }
-                if (!options.empty()) {
-                    hoveredIndex = std::max(0, hoveredIndex - 1);
-                }
-                return;
-
             case SDLK_DOWN:
                 if (!expanded) {
                     if (!options.empty()) {
                         expanded = true;
                         notifyExpanded = true;
-                        const int hi = (int)options.size() - 1;
-                        hoveredIndex = std::clamp((int)selectedIndex.get(), 0, hi);
+                        revealHot = true;
+                        hoveredIndex = std::clamp((int)selectedIndex.get(), 0, last);
                     }
                     return;
                 }
-                if (!options.empty()) {
-                    hoveredIndex = std::min((int)options.size() - 1, hoveredIndex + 1);
-                }
+                setHot_(hoveredIndex + (sym == SDLK_UP ? -1 : 1));
                 return;
+
+            case SDLK_PAGEUP:   if (expanded) setHot_(hoveredIndex - page); return;
+            case SDLK_PAGEDOWN: if (expanded) setHot_(hoveredIndex + page); return;
+            case SDLK_HOME:     if (expanded) setHot_(0); return;
+            case SDLK_END:      if (expanded) setHot_(last); return;
         }
     }
 }
 
 void UIComboBox::update(float) {
-    int mx, my; SDL_GetMouseState(&mx, &my);
-    SDL_Point p{ mx, my };
-    hovered = SDL_PointInRect(&p, &bounds);
-
-    if (!expanded || options.empty()) return;
-
-    if (dropdownPositionValid) {
-        SDL_Rect listRect = getDropdownRect();
-        const int ih = bounds.h;
-
-        if (SDL_PointInRect(&p, &listRect)) {
-            int relY = my - listRect.y;
-            int idx = relY / ih;
-            idx = std::clamp(idx, 0, (int)options.size() - 1);
-            hoveredIndex = idx;
-        }
+    // The bound index changes behind our back; report it to cached layers.
+    if (selectedIndex.get() != seenIndex) {
+        seenIndex = selectedIndex.get();
+        markDirty();
     }
 }
 
@@ -198,16 +323,23 @@ bool UIComboBox::isInside(int x, int y) const {
 
 UIComboBox* UIComboBox::setTextColor(SDL_Color c) {
     customTextColor = c;
+    markDirty();
     return this;
 }
 
 void UIComboBox::renderField(SDL_Renderer* renderer) {
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeComboBoxStyle(th, ds);
+    const auto st = resolvedStyle<UIComboBoxStyle>();
     TTF_Font* activeFont = font ? font : (th.font ? th.font : UIConfig::getDefaultFont());
     if (!activeFont) return;
 
+    const LookStamp look = lookStamp();
+    if (look != seenLook) {
+        seenLook = look;
+        fieldText.invalidateAll();
+        itemText.invalidateAll();
+    }
+
     const int effRadius   = (cornerRadius > 0 ? cornerRadius : st.radius);
     const int effBorderPx = st.borderPx;
 
@@ -226,26 +358,24 @@ void UIComboBox::renderField(SDL_Renderer* renderer) {
         UIHelpers::FillRoundedRect(renderer, field.x, field.y, field.w, field.h, effRadius, st.fieldBg);
     }
 
+    const int caretW = 12;
+    const int caretH = 7;
+
     int sel = selectedIndex.get();
-    std::string display = (sel >= 0 && sel < (int)options.size()) ? options[sel] : placeholder;
+    const bool hasSel = sel >= 0 && sel < (int)options.size();
     SDL_Color textCol   = (sel >= 0) ? st.fieldFg : st.placeholder;
     if (customTextColor) textCol = *customTextColor;
 
-    auto surface = UIHelpers::MakeSurface(
-        TTF_RenderUTF8_Blended(activeFont, display.c_str(), textCol)
-    );
-    
-    if (surface) {
-        auto texture = UIHelpers::MakeTexture(
-            SDL_CreateTextureFromSurface(renderer, surface.get())
-        );
-        
-        SDL_Rect tr = { field.x + st.padX, field.y + (field.h - surface->h)/2, surface->w, surface->h };
-        SDL_RenderCopy(renderer, texture.get(), nullptr, &tr);
+    // The placeholder is keyed one past the last option.
+    const size_t key = hasSel ? (size_t)sel : options.size();
+    const auto text = fieldText.get(renderer, activeFont, textCol, key, field.w - 2*st.padX - caretW,
+                                    [&] { return hasSel ? options[sel] : placeholder; });
+    if (text.texture) {
+        SDL_Rect src = { 0, 0, text.w, text.h };
+        SDL_Rect tr = { field.x + st.padX, field.y + (field.h - text.h)/2, text.w, text.h };
+        SDL_RenderCopy(renderer, text.texture, &src, &tr);
     }
 
-    const int caretW = 12;
-    const int caretH = 7;
     int cx = field.x + field.w - st.padX;
     int cy = field.y + field.h/2;
     SDL_Color caretCol = st.caret;
@@ -254,12 +384,14 @@ void UIComboBox::renderField(SDL_Renderer* renderer) {
     UIHelpers::DrawChevronDown(renderer, cx, cy, caretW, caretH, thick, caretCol);
 }
 
+// Only the rows inside the menu are drawn; their text comes from a texture
+// pool sized to the visible rows, so long option lists cost no more per
+// frame than short ones.
 void UIComboBox::renderDropdown(SDL_Renderer* renderer) {
     if (!expanded || options.empty()) return;
     
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeComboBoxStyle(th, ds);
+    const auto st = resolvedStyle<UIComboBoxStyle>();
     TTF_Font* activeFont = font ? font : (th.font ? th.font : UIConfig::getDefaultFont());
     if (!activeFont) return;
 
@@ -268,86 +400,66 @@ void UIComboBox::renderDropdown(SDL_Renderer* renderer) {
     const int ih = bounds.h;
     
     updateDropdownRect(renderer);
-    SDL_Rect menu = getDropdownRect();
-    
-    SDL_Color mb = st.menuBg;
-    SDL_Color mborder = st.menuBorder;
-    int sel = selectedIndex.get();
+    scrollTo_(firstVisible);
+    if (revealHot) { ensureVisible_(hoveredIndex); revealHot = false; }
+    itemText.setCapacity((size_t)visibleItems + 2);
 
+    const SDL_Rect menu = getDropdownRect();
     if (effBorderPx > 0) {
-        UIHelpers::FillRoundedRect(renderer, menu.x, menu.y, menu.w, menu.h, effRadius, mborder);
-        
-        SDL_Rect innerMenu = { 
-            menu.x + effBorderPx, 
-            menu.y + effBorderPx, 
-            menu.w - 2*effBorderPx, 
-            menu.h - 2*effBorderPx 
-        };
-        UIHelpers::FillRoundedRect(renderer, innerMenu.x, innerMenu.y, innerMenu.w, innerMenu.h, 
-                                   std::max(0, effRadius - effBorderPx), mb);
-        
-        int y = innerMenu.y;
-        for (int i = 0; i < (int)options.size(); ++i) {
-            SDL_Rect row{ innerMenu.x + 4, y, innerMenu.w - 8, ih };
-            bool isSel = (i == sel);
-            bool isHot = (i == hoveredIndex);
-
-            if (isSel) {
-                UIHelpers::FillRoundedRect(renderer, row.x, row.y + 2, row.w, row.h - 4, 6, st.itemSelectedBg);
-            } else if (isHot) {
-                UIHelpers::FillRoundedRect(renderer, row.x, row.y + 2, row.w, row.h - 4, 6, st.itemHoverBg);
-            }
+        UIHelpers::FillRoundedRect(renderer, menu.x, menu.y, menu.w, menu.h, effRadius, st.menuBorder);
+        UIHelpers::FillRoundedRect(renderer, menu.x + effBorderPx, menu.y + effBorderPx,
+                                   menu.w - 2*effBorderPx, menu.h - 2*effBorderPx,
+                                   std::max(0, effRadius - effBorderPx), st.menuBg);
+    } else {
+        UIHelpers::FillRoundedRect(renderer, menu.x, menu.y, menu.w, menu.h, effRadius, st.menuBg);
+    }
 
-            SDL_Color ic = isSel ? st.itemSelectedFg : st.itemFg;
-            
-            auto itemSurface = UIHelpers::MakeSurface(
-                TTF_RenderUTF8_Blended(activeFont, options[i].c_str(), ic)
-            );
-            
-            if (itemSurface) {
-                auto itemTexture = UIHelpers::MakeTexture(
-                    SDL_CreateTextureFromSurface(renderer, itemSurface.get())
-                );
-                
-                SDL_Rect ir = { row.x + 8, row.y + (row.h - itemSurface->h)/2, itemSurface->w, itemSurface->h };
-                SDL_RenderCopy(renderer, itemTexture.get(), nullptr, &ir);
-            }
-            
-            y += ih;
+    const SDL_Rect list = listRect_();
+    SDL_Rect prevClip;
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer);
+    SDL_RenderGetClipRect(renderer, &prevClip);
+    SDL_Rect clip = list;
+    if (hadClip) SDL_IntersectRect(&prevClip, &list, &clip);
+    SDL_RenderSetClipRect(renderer, &clip);
+
+    const int sel = selectedIndex.get();
+    const int end = std::min((int)options.size(), firstVisible + visibleItems);
+    for (int i = firstVisible; i < end; ++i) {
+        SDL_Rect row{ list.x + 4, list.y + (i - firstVisible) * ih, list.w - 8, ih };
+        bool isSel = (i == sel);
+        bool isHot = (i == hoveredIndex);
+
+        if (isSel) {
+            UIHelpers::FillRoundedRect(renderer, row.x, row.y + 2, row.w, row.h - 4, 6, st.itemSelectedBg);
+        } else if (isHot) {
+            UIHelpers::FillRoundedRect(renderer, row.x, row.y + 2, row.w, row.h - 4, 6, st.itemHoverBg);
         }
-    } else {
-        UIHelpers::FillRoundedRect(renderer, menu.x, menu.y, menu.w, menu.h, effRadius, mb);
-        
-        int y = menu.y;
-        for (int i = 0; i < (int)options.size(); ++i) {
-            SDL_Rect row{ menu.x + 4, y, menu.w - 8, ih };
-            bool isSel = (i == sel);
-            bool isHot = (i == hoveredIndex);
-
-            if (isSel) {
-                UIHelpers::FillRoundedRect(renderer, row.x, row.y + 2, row.w, row.h - 4, 6, st.itemSelectedBg);
-            } else if (isHot) {
-                UIHelpers::FillRoundedRect(renderer, row.x, row.y + 2, row.w, row.h - 4, 6, st.itemHoverBg);
-            }
 
-            SDL_Color ic = isSel ? st.itemSelectedFg : st.itemFg;
-            
-            auto itemSurface = UIHelpers::MakeSurface(
-                TTF_RenderUTF8_Blended(activeFont, options[i].c_str(), ic)
-            );
-            
-            if (itemSurface) {
-                auto itemTexture = UIHelpers::MakeTexture(
-                    SDL_CreateTextureFromSurface(renderer, itemSurface.get())
-                );
-                
-                SDL_Rect ir = { row.x + 8, row.y + (row.h - itemSurface->h)/2, itemSurface->w, itemSurface->h };
-                SDL_RenderCopy(renderer, itemTexture.get(), nullptr, &ir);
-            }
-            
-            y += ih;
+        SDL_Color ic = isSel ? st.itemSelectedFg : st.itemFg;
+        const auto text = itemText.get(renderer, activeFont, ic, (size_t)i, row.w - 16,
+                                       [&] { return options[i]; });
+        if (text.texture) {
+            SDL_Rect src = { 0, 0, text.w, text.h };
+            SDL_Rect ir = { row.x + 8, row.y + (row.h - text.h)/2, text.w, text.h };
+            SDL_RenderCopy(renderer, text.texture, &src, &ir);
         }
     }
+
+    if ((int)options.size() > visibleItems) {
+        const SDL_Rect track = scrollTrack_();
+        const int n = (int)options.size();
+        const int thumbH = std::min(track.h, std::max(MIN_THUMB_PX, track.h * visibleItems / n));
+        const int range = n - visibleItems;
+        const int thumbY = track.y + (range > 0 ? (track.h - thumbH) * firstVisible / range : 0);
+        SDL_Rect thumb{ track.x + 1, thumbY, track.w - 3, thumbH };
+        SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(renderer, th.sliderThumbColor.r, th.sliderThumbColor.g, th.sliderThumbColor.b,
+                               draggingScroll ? 255 : 180);
+        SDL_RenderFillRect(renderer, &thumb);
+    }
+
+    SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
 }
 
 void UIComboBox::render(SDL_Renderer* renderer) {
@@ -363,4 +475,4 @@ bool UIComboBox::isHoveringDropdown(int mx, int my) const {
     SDL_Point p{ mx, my };
     SDL_Rect dropdownRect = getDropdownRect();
     return SDL_PointInRect(&p, &dropdownRect);
-}
\ No newline at end of file
+}
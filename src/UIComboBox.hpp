@@ -3,6 +3,7 @@
 #include "UIElement.hpp"
 #include "UIConfig.hpp"
 #include "UIHelpers.hpp"
+#include "UITextRowCache.hpp"
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL.h>
 #include <vector>
@@ -25,12 +26,15 @@ public:
 
     bool isFocusable() const override { return focusable; }
 
-    UIComboBox* setPlaceholder(std::string ph) { placeholder = std::move(ph); return this; }
+    UIComboBox* setPlaceholder(std::string ph) { placeholder = std::move(ph); fieldText.invalidateAll(); markDirty(); return this; }
+    // Rows shown before the dropdown scrolls.
+    UIComboBox* setMaxVisibleItems(int n) { maxVisibleItems = std::max(1, n); dropdownPositionValid = false; markDirty(); return this; }
 
     void handleEvent(const SDL_Event& e) override;
     void update(float dt) override;
     void render(SDL_Renderer* renderer) override;
     bool isInside(int x, int y) const override;
+    bool hasCustomHitTest() const override { return true; }
     UIComboBox* setTextColor(SDL_Color c);
 
     UIComboBox* setFocusable(bool f) { focusable = f; return this; }
@@ -48,6 +52,7 @@ public:
 private:
     std::vector<std::string> options;
     std::reference_wrapper<int> selectedIndex;
+    int seenIndex = -1;
     std::function<void(int)> onSelect;
     TTF_Font* font = nullptr;
     std::optional<SDL_Color> customTextColor;
@@ -66,6 +71,35 @@ private:
     
     bool notifyExpanded = false;
     
+    int  maxVisibleItems = 10;
+    mutable int visibleItems = 0;
+    int  firstVisible = 0;
+    bool draggingScroll = false;
+    bool revealHot = false;
+
+    UITextRowCache itemText;
+    UITextRowCache fieldText{ 1 };
+    LookStamp seenLook;
+
+    // Case-folded options in sorted order; rankOf maps an option to its
+    // position so repeated keystrokes can cycle through equal prefixes.
+    std::vector<std::pair<std::string, int>> typeIndex;
+    std::vector<int> rankOf;
+    bool typeIndexDirty = true;
+    std::string typed;
+    Uint32 lastTypedAt = 0;
+
     void updateDropdownRect(SDL_Renderer* renderer) const;
     SDL_Rect getDropdownRect() const;
+    SDL_Rect listRect_() const;
+    SDL_Rect scrollTrack_() const;
+    int  itemAt_(int x, int y) const;
+    void scrollTo_(int first);
+    void ensureVisible_(int index);
+    void setHot_(int index);
+    void scrollFromTrack_(int y);
+    void buildTypeIndex_();
+    int  findPrefix_(const std::string& prefix, int current, bool advance) const;
+    bool typeAhead_(char c);
+    void commit_(int index);
 };
\ No newline at end of file
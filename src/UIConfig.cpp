@@ -1,14 +1,19 @@
 #include "UIConfig.hpp"
 #include "UITheme.hpp"
 #include "UIStyle.hpp"
+#include "UIIntern.hpp"
 #include <unordered_map>
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <vector>
 
 TTF_Font* UIConfig::defaultFont = nullptr;
 UITheme   UIConfig::defaultTheme;
 UIStyle   UIConfig::defaultStyle = MakeClassicStyle();
+Uint64    UIConfig::themeGen = 0;
+Uint64    UIConfig::styleGen = 0;
+Uint64    UIConfig::lookGen = 1;
 
 static UIStyle styleFromEnum(StyleId id) {
     switch (id) {
@@ -61,19 +66,65 @@ static std::string lower(std::string_view s) {
     return out;
 }
 
-void UIConfig::setDefaultFont(TTF_Font* font) { defaultFont = font; }
+static std::vector<std::pair<int, UIConfig::LookListener>> gLookListeners;
+static int gNextLookListener = 1;
+static int gLookBatch = 0;
+static bool gLookPending = false;
+
+// Coalesces the setStyle + setTheme pair in setLook into one notification.
+struct LookBatch {
+    LookBatch() { ++gLookBatch; }
+    ~LookBatch() {
+        if (--gLookBatch == 0 && gLookPending) UIConfig::notifyLookChanged();
+    }
+};
+
+void UIConfig::notifyLookChanged() {
+    if (gLookBatch > 0) { gLookPending = true; return; }
+    gLookPending = false;
+    ++lookGen;
+    auto listeners = gLookListeners;
+    for (auto& [id, fn] : listeners) if (fn) fn();
+}
+
+int UIConfig::addLookListener(LookListener fn) {
+    const int id = gNextLookListener++;
+    gLookListeners.emplace_back(id, std::move(fn));
+    return id;
+}
+
+void UIConfig::removeLookListener(int id) {
+    gLookListeners.erase(std::remove_if(gLookListeners.begin(), gLookListeners.end(),
+                                        [id](const auto& l){ return l.first == id; }),
+                         gLookListeners.end());
+}
+
+void UIConfig::setDefaultFont(TTF_Font* font) {
+    if (defaultFont == font) return;
+    defaultFont = font;
+    notifyLookChanged();
+}
 TTF_Font* UIConfig::getDefaultFont() { return defaultFont; }
 TTF_Font** UIConfig::getDefaultFontPtr() { return &defaultFont; }
 
-void UIConfig::setTheme(const UITheme& theme) { defaultTheme = theme; }
+void UIConfig::setTheme(const UITheme& theme) {
+    defaultTheme = theme;
+    themeGen = UIInterned<UITheme>::nextGeneration();
+    notifyLookChanged();
+}
 const UITheme& UIConfig::getTheme() { return defaultTheme; }
 
-void UIConfig::setStyle(const UIStyle& style) { defaultStyle = style; }
+void UIConfig::setStyle(const UIStyle& style) {
+    defaultStyle = style;
+    styleGen = UIInterned<UIStyle>::nextGeneration();
+    notifyLookChanged();
+}
 const UIStyle& UIConfig::getStyle() { return defaultStyle; }
 
 void UIConfig::setStyle(StyleId id) { setStyle(styleFromEnum(id)); }
 void UIConfig::setTheme(ThemeId id) { setTheme(themeFromEnum(id)); }
 void UIConfig::setLook(StyleId s, ThemeId t) {
+    LookBatch batch;
     setStyle(styleFromEnum(s));
     setTheme(themeFromEnum(t));
 }
@@ -91,6 +142,7 @@ void UIConfig::setTheme(std::string_view name) {
 }
 
 void UIConfig::setLook(std::string_view styleName, std::string_view themeName) {
+    LookBatch batch;
     setStyle(styleName);
     setTheme(themeName);
 }
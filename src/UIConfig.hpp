@@ -1,6 +1,7 @@
 #pragma once
 #include <SDL2/SDL_ttf.h>
 #include <string_view>
+#include <functional>
 #include "UITheme.hpp"
 #include "LookIds.hpp"
 
@@ -35,9 +36,27 @@ public:
 
     static TTF_Font** getDefaultFontPtr();
 
+    // Bumped by every setTheme/setStyle; keys caches built from the defaults.
+    static Uint64 themeGeneration() { return themeGen; }
+    static Uint64 styleGeneration() { return styleGen; }
+
+    // Bumped once per change to the default theme, style or font (setLook
+    // counts as one change). Caches compare it instead of their inputs.
+    static Uint64 lookGeneration() { return lookGen; }
+    // Call after changing the default font through getDefaultFontPtr() or
+    // mutating it in place (e.g. TTF_SetFontSize).
+    static void notifyLookChanged();
+    // Listeners run on the UI thread right after the generation changes.
+    using LookListener = std::function<void()>;
+    static int  addLookListener(LookListener fn);
+    static void removeLookListener(int id);
+
 private:
     static TTF_Font* defaultFont;
     static UITheme   defaultTheme;
 
     static UIStyle   defaultStyle;
+    static Uint64    themeGen;
+    static Uint64    styleGen;
+    static Uint64    lookGen;
 };
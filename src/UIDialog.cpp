@@ -27,9 +27,8 @@ UIDialog::UIDialog(const std::string& title,
 void UIDialog::render(SDL_Renderer* renderer) {
     UIPopup::render(renderer);
 
-    const UITheme& th = getTheme();
-    const auto lst = MakeLabelStyle(th);
-    const auto pst = MakePopupStyle(th, getStyle());
+    const auto lst = resolvedStyle<UILabelStyle>();
+    const auto pst = resolvedStyle<PopupStyle>();
     TTF_Font* font = UIConfig::getDefaultFont();
     if (!font) return;
 
@@ -87,7 +86,7 @@ void UIDialog::handleEvent(const SDL_Event& e) {
 }
 
 void UIDialog::close() {
-    visible = false;
+    setVisible(false);
 }
 
 void UIDialog::setBounds(int x, int y, int w, int h) {
@@ -98,7 +97,7 @@ void UIDialog::setBounds(int x, int y, int w, int h) {
 void UIDialog::layoutButtons() {
     if (!okButton || !cancelButton) return;
 
-    const auto pst = MakePopupStyle(getTheme(), getStyle());
+    const auto pst = resolvedStyle<PopupStyle>();
     const int btnW = 100, btnH = 40;
     const int gap  = pst.pad / 2;
 
@@ -4,9 +4,27 @@
 #include "UIConfig.hpp"
 #include "UIStyles.hpp"
 #include "UIHelpers.hpp"
+#include "UITimerWheel.hpp"
+#include "UIIntern.hpp"
+#include <string_view>
+
+class UIElement;
+
+// Told when an element's geometry, visibility or enabled state changes
+// through its setters. UIManager watches its top-level elements this way so the
+// hit-test arrays are current between frames.
+class UIElementObserver {
+public:
+    virtual void elementChanged(UIElement* el) = 0;
+protected:
+    ~UIElementObserver() = default;
+};
 
 class UIElement {
 public:
+    // Change these through the setters. After writing the fields directly,
+    // call one (e.g. setBounds with the new values) so UIManager's hit-test
+    // mirror and cached layers pick the change up; nothing polls for it.
     SDL_Rect bounds;
     bool visible = true;
     bool enabled = true;
@@ -15,18 +33,47 @@ public:
     virtual bool isHovered() const { return false; }
     virtual void update(float dt) = 0;
     virtual void render(SDL_Renderer* renderer) = 0;
-    virtual void setPosition(int x, int y) { bounds.x = x; bounds.y = y; }
-    virtual void setSize(int w, int h) { bounds.w = w; bounds.h = h; }
-    virtual void setBounds(int x, int y, int w, int h) { bounds = {x, y, w, h}; }
+    virtual void setPosition(int x, int y) { bounds.x = x; bounds.y = y; changed_(); }
+    virtual void setSize(int w, int h) { bounds.w = w; bounds.h = h; changed_(); }
+    virtual void setBounds(int x, int y, int w, int h) { bounds = {x, y, w, h}; changed_(); }
     virtual bool isFocusable() const { return false; }
+    // False if update() has no per-frame work, so UIManager and containers
+    // skip it. Caret blink, auto-repeat and marquee run from the timer wheel
+    // either way; widgets that poll bound values or drain queues keep true.
+    // Read once when the element is added.
+    virtual bool wantsFrameUpdate() const { return true; }
+
+    // Overrides are interned: elements with equal themes/styles share one copy.
+    void setTheme(const UITheme& theme) { customTheme = UIInterned<UITheme>(theme); markDirty(); }
+    const UITheme& getTheme() const { return customTheme ? *customTheme : UIConfig::getTheme(); }
 
-    void setTheme(const UITheme& theme) { customTheme = theme; hasCustomTheme = true; }
-    const UITheme& getTheme() const { return hasCustomTheme ? customTheme : UIConfig::getTheme(); }
+    void setStyle(const UIStyle& style) { customStyle = UIInterned<UIStyle>(style); markDirty(); }
+    const UIStyle& getStyle() const { return customStyle ? *customStyle : UIConfig::getStyle(); }
+    void clearThemeOverride() { customTheme.reset(); markDirty(); }
+    void clearStyleOverride() { customStyle.reset(); markDirty(); }
 
-    void setStyle(const UIStyle& style) { customStyle = style; hasCustomStyle = true; }
-    const UIStyle& getStyle() const { return hasCustomStyle ? customStyle : UIConfig::getStyle(); }
-    void clearThemeOverride() { hasCustomTheme = false; }
-    void clearStyleOverride() { hasCustomStyle = false; }
+    // Copy-on-write edit of the effective theme/style, e.g.
+    // el->editTheme([](UITheme& t) { t.textColor = {255,0,0,255}; });
+    template<class F> void editTheme(F&& f) { UITheme t = getTheme(); f(t); setTheme(t); }
+    template<class F> void editStyle(F&& f) { UIStyle s = getStyle(); f(s); setStyle(s); }
+    bool hasThemeOverride() const { return (bool)customTheme; }
+    bool hasStyleOverride() const { return (bool)customStyle; }
+
+    Uint64 themeGeneration() const { return customTheme ? customTheme.generation() : UIConfig::themeGeneration(); }
+    Uint64 styleGeneration() const { return customStyle ? customStyle.generation() : UIConfig::styleGeneration(); }
+    // Changes whenever anything this element's look depends on changes:
+    // UIConfig defaults and font, or this element's own overrides.
+    struct LookStamp {
+        Uint64 config = 0, theme = 0, style = 0;
+        bool operator==(const LookStamp& o) const { return config == o.config && theme == o.theme && style == o.style; }
+        bool operator!=(const LookStamp& o) const { return !(*this == o); }
+    };
+    LookStamp lookStamp() const { return { UIConfig::lookGeneration(), customTheme.generation(), customStyle.generation() }; }
+
+    // Cached equivalent of Make*Style(getTheme(), getStyle()).
+    template<class S> S resolvedStyle() const {
+        return UIStyleCache<S>::get(getTheme(), themeGeneration(), getStyle(), styleGeneration());
+    }
 
     SDL_Point getPosition() const { return { bounds.x, bounds.y }; }
     SDL_Point getSize() const { return { bounds.w, bounds.h }; }
@@ -34,19 +81,68 @@ public:
         return x >= bounds.x && x <= bounds.x + bounds.w &&
                y >= bounds.y && y <= bounds.y + bounds.h;
     }
-    void setEnabled(bool e) { enabled = e; }
+    // True if isInside is overridden; UIManager hit-tests everything else
+    // from its own copy of bounds without a virtual call.
+    virtual bool hasCustomHitTest() const { return false; }
+
+    // Text editors opt in to have UIManager collect consecutive SDL_TEXTINPUT
+    // events, or auto-repeats of one key, while focused and deliver them once
+    // per frame: the text concatenated, or the repeat count with the last
+    // key event. Anything else flushes the pending burst first.
+    virtual bool acceptsInputBursts() const { return false; }
+
+    // Tab (forward) or Shift+Tab while this element has focus. Containers
+    // with focusable children move their inner focus and return true; false
+    // lets UIManager move on to the next element. fromOutside: focus has just
+    // arrived by that key, so start at the first (or last) child.
+    virtual bool stepFocus(bool, bool) { return false; }
+    virtual void handleTextBurst(std::string_view) {}
+    virtual void handleKeyRepeat(const SDL_KeyboardEvent&, int) {}
+
+    void setEnabled(bool e) { if (enabled != e) { enabled = e; enabledChanged(); changed_(); } }
     bool isEnabled() const { return enabled; }
+    void setVisible(bool v) { if (visible != v) { visible = v; changed_(); } }
+    bool isVisible() const { return visible; }
+
+    // Set by UIManager (and propagated by containers); timers owned by this
+    // element are cancelled when it is detached or destroyed.
+    virtual void attachTimers(UITimerWheel* wheel) {
+        if (timers == wheel) return;
+        if (timers) timers->cancelAll(this);
+        timers = wheel;
+    }
+    UITimerWheel* timerWheel() const { return timers; }
+    void setObserver(UIElementObserver* o) { observer = o; }
+
+    // Set by containers on their children. markDirty() tells every ancestor
+    // that this element's pixels changed so cached layers repaint; call it
+    // after changing state that render() reads outside handleEvent/setters.
+    UIElement* parent() const { return parentEl; }
+    void setParent(UIElement* p) { parentEl = p; }
+    virtual void markDirty() { if (parentEl) parentEl->childDamaged(this); }
 
     UIElement() = default;
-    virtual ~UIElement() = default;
+    virtual ~UIElement() { if (timers) timers->cancelAll(this); }
     UIElement(const UIElement&) = delete;
     UIElement& operator=(const UIElement&) = delete;
     UIElement(UIElement&&) = default;
     UIElement& operator=(UIElement&&) = default;
 
+protected:
+    // A child's markDirty() lands here; containers that cache their
+    // children's pixels separately from their own override it.
+    virtual void childDamaged(UIElement*) { markDirty(); }
+    // Runs from setEnabled() before the repaint, for widgets that drop
+    // transient hover/press state when disabled.
+    virtual void enabledChanged() {}
+
+    UITimerWheel* timers = nullptr;
+    UIElement* parentEl = nullptr;
+    UIElementObserver* observer = nullptr;
+
 private:
-    UITheme customTheme;
-    UIStyle customStyle;
-    bool hasCustomTheme = false;
-    bool hasCustomStyle = false;
+    void changed_() { if (observer) observer->elementChanged(this); markDirty(); }
+
+    UIInterned<UITheme> customTheme;
+    UIInterned<UIStyle> customStyle;
 };
\ No newline at end of file
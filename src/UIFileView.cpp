@@ -0,0 +1,342 @@
+#include "UIFileView.hpp"
+#include "UIWorker.hpp"
+#include <algorithm>
+#include <cstring>
+
+static constexpr int WHEEL_LINES   = 3;
+static constexpr int KEY_X_PX      = 48;
+static constexpr int PAD_PX        = 6;
+static constexpr int MAX_LINE_PX   = 4096;            // longer lines are cut off
+static constexpr size_t MAX_LINE_BYTES = 2048;        // bytes copied out per line
+static constexpr int TAB_WIDTH     = 4;
+static constexpr Uint64 FIRST_SLICE = 64 * 1024;      // small, so the first screen comes quickly
+static constexpr Uint64 SLICE       = 8 * 1024 * 1024;
+static constexpr Uint32 WAKE_MS     = 100;
+static constexpr Uint32 STALE_CHECK_MS = 500;         // one stat() per interval
+
+// Kept apart from UIWorker::shared() so indexing a huge file does not hold
+// up table sorts.
+static UIWorker& indexer() {
+    static UIWorker worker;
+    return worker;
+}
+
+// Tabs expanded, control bytes blanked, cut on a UTF-8 boundary.
+static std::string displayText(const char* p, size_t len) {
+    if (len > MAX_LINE_BYTES) {
+        len = MAX_LINE_BYTES;
+        while (len > 0 && ((unsigned char)p[len] & 0xC0) == 0x80) --len;
+    }
+    std::string out;
+    out.reserve(len);
+    int col = 0;
+    for (size_t i = 0; i < len; ++i) {
+        const unsigned char c = (unsigned char)p[i];
+        if (c == '\t') {
+            const int n = TAB_WIDTH - col % TAB_WIDTH;
+            out.append((size_t)n, ' ');
+            col += n;
+            continue;
+        }
+        out += (c < 0x20 || c == 0x7F) ? ' ' : (char)c;
+        if ((c & 0xC0) != 0x80) ++col;
+    }
+    return out;
+}
+
+UIFileView::UIFileView(int x, int y, int w, int h) {
+    bounds = { x, y, w, h };
+}
+
+UIFileView::~UIFileView() {
+    if (index) index->cancel.store(true, std::memory_order_relaxed);
+}
+
+bool UIFileView::open(const std::string& p) {
+    close();
+    auto ix = std::make_shared<Index>();
+    if (!ix->file.open(p)) return false;
+    const Uint64 maxCheckpoints = ix->file.size() / Index::STRIDE + 2;
+    ix->blocks.resize((size_t)(maxCheckpoints / Index::BLOCK + 1));
+
+    index = ix;
+    filePath = p;
+    indexDone = false;
+    indexer().post([ix] { build_(ix); });
+    return true;
+}
+
+void UIFileView::close() {
+    if (index) index->cancel.store(true, std::memory_order_relaxed);
+    index.reset();
+    filePath.clear();
+    knownLines = 0;
+    indexDone = true;
+    pendingLine = (Uint64)-1;
+    maxWidth = 0;
+    bars.reset();
+    text.invalidateAll();
+    markDirty();
+}
+
+// Runs on the indexer thread. Checkpoint k is the offset of line k*STRIDE;
+// it is written before `lines` is released past it.
+void UIFileView::build_(std::shared_ptr<Index> ix) {
+    const char* d = ix->file.data();
+    const Uint64 n = ix->file.size();
+    Uint64 pos = 0, line = 0, cps = 0;
+
+    auto addCheckpoint = [&](Uint64 off) {
+        auto& block = ix->blocks[(size_t)(cps / Index::BLOCK)];
+        if (!block) block.reset(new Uint64[Index::BLOCK]);
+        block[cps % Index::BLOCK] = off;
+        ++cps;
+    };
+    addCheckpoint(0);
+
+    Uint64 slice = FIRST_SLICE;
+    Uint32 lastWake = 0;
+    bool first = true;
+    while (pos < n) {
+        if (ix->cancel.load(std::memory_order_relaxed)) return;
+        const Uint64 end = std::min(n, pos + slice);
+        while (pos < end) {
+            const void* nl = std::memchr(d + pos, '\n', (size_t)(end - pos));
+            if (!nl) { pos = end; break; }
+            pos = (Uint64)((const char*)nl - d) + 1;
+            if (++line % Index::STRIDE == 0) addCheckpoint(pos);
+        }
+        ix->scanned.store(pos, std::memory_order_relaxed);
+        ix->lines.store(line, std::memory_order_release);
+        slice = SLICE;
+
+        const Uint32 now = SDL_GetTicks();
+        if (first || now - lastWake >= WAKE_MS) {
+            first = false;
+            lastWake = now;
+            UIWorker::wakeUI();
+        }
+    }
+    if (n > 0 && d[n - 1] != '\n') ++line;   // last line has no terminator
+    ix->lines.store(line, std::memory_order_release);
+    ix->done.store(true, std::memory_order_release);
+    UIWorker::wakeUI();
+}
+
+bool UIFileView::isIndexing() const { return index && !indexDone; }
+
+float UIFileView::indexProgress() const {
+    if (!index) return 0.0f;
+    const Uint64 n = index->file.size();
+    if (indexDone || n == 0) return 1.0f;
+    return (float)((double)index->scanned.load(std::memory_order_relaxed) / (double)n);
+}
+
+void UIFileView::update(float) {
+    if (!index) return;
+    const Uint32 now = SDL_GetTicks();
+    if (now - lastStaleCheck >= STALE_CHECK_MS) {
+        lastStaleCheck = now;
+        if (index->file.isStale(filePath)) {
+            const Uint64 top = firstVisibleLine();
+            const std::string p = filePath;
+            if (open(p)) scrollToLine(top);
+            return;
+        }
+    }
+    const bool done = index->done.load(std::memory_order_acquire);
+    const Uint64 n = index->lines.load(std::memory_order_acquire);
+    if (n != knownLines || done != indexDone) {
+        knownLines = n;
+        indexDone = done;
+        markDirty();
+    }
+    if (pendingLine != (Uint64)-1 && (pendingLine < knownLines || indexDone)) {
+        const Uint64 l = pendingLine;
+        pendingLine = (Uint64)-1;
+        scrollToLine(l);
+    }
+}
+
+// line < knownLines. At most STRIDE - 1 newline searches past the checkpoint.
+Uint64 UIFileView::lineStart_(Uint64 line) const {
+    const char* d = index->file.data();
+    const Uint64 n = index->file.size();
+    const Uint64 k = line / Index::STRIDE;
+    Uint64 off = index->checkpoint(k);
+    for (Uint64 i = k * Index::STRIDE; i < line && off < n; ++i) {
+        const void* nl = std::memchr(d + off, '\n', (size_t)(n - off));
+        off = nl ? (Uint64)((const char*)nl - d) + 1 : n;
+    }
+    return off;
+}
+
+// Offset of the terminator (or end of file), '\r' excluded.
+Uint64 UIFileView::lineEnd_(Uint64 start) const {
+    const char* d = index->file.data();
+    const Uint64 n = index->file.size();
+    if (start >= n) return n;
+    const void* nl = std::memchr(d + start, '\n', (size_t)(n - start));
+    Uint64 end = nl ? (Uint64)((const char*)nl - d) : n;
+    if (end > start && d[end - 1] == '\r') --end;
+    return end;
+}
+
+std::string UIFileView::lineText(Uint64 line) const {
+    if (!index || line >= knownLines) return {};
+    const Uint64 s = lineStart_(line);
+    return std::string(index->file.data() + s, (size_t)(lineEnd_(s) - s));
+}
+
+Uint64 UIFileView::lineAtOffset(Uint64 offset) const {
+    if (!index || knownLines == 0) return 0;
+    const char* d = index->file.data();
+    const Uint64 n = index->file.size();
+    offset = std::min(offset, n);
+
+    // Last checkpoint at or before offset.
+    Uint64 lo = 0, hi = (knownLines - 1) / Index::STRIDE + 1;
+    while (hi - lo > 1) {
+        const Uint64 mid = lo + (hi - lo) / 2;
+        if (index->checkpoint(mid) <= offset) lo = mid; else hi = mid;
+    }
+    Uint64 line = lo * Index::STRIDE, off = index->checkpoint(lo);
+    while (line + 1 < knownLines && off < n) {
+        const void* nl = std::memchr(d + off, '\n', (size_t)(n - off));
+        const Uint64 e = nl ? (Uint64)((const char*)nl - d) : n;
+        if (e >= offset) break;
+        off = e + 1;
+        ++line;
+    }
+    return line;
+}
+
+void UIFileView::scrollToLine(Uint64 line) {
+    if (!index) return;
+    if (line >= knownLines && !indexDone) {
+        pendingLine = line;
+        return;
+    }
+    pendingLine = (Uint64)-1;
+    setScroll_(1, (double)line * lineHeight_());
+}
+
+Uint64 UIFileView::firstVisibleLine() const {
+    return (Uint64)(bars.offset(1) / lineHeight_());
+}
+
+UIFileView* UIFileView::setFont(TTF_Font* f) {
+    font = f;
+    maxWidth = 0;
+    text.invalidateAll();
+    markDirty();
+    return this;
+}
+
+TTF_Font* UIFileView::activeFont_() const {
+    if (font) return font;
+    const UITheme& th = getTheme();
+    return th.font ? th.font : UIConfig::getDefaultFont();
+}
+
+int UIFileView::lineHeight_() const {
+    TTF_Font* f = activeFont_();
+    return f ? std::max(1, TTF_FontHeight(f)) : 16;
+}
+
+UIScrollBars::Layout UIFileView::layout_() const {
+    const int b = resolvedStyle<UITextAreaStyle>().borderPx + PAD_PX;
+    const SDL_Rect area{ bounds.x + b, bounds.y + b, std::max(0, bounds.w - 2*b), std::max(0, bounds.h - 2*b) };
+    return bars.layout(area, (double)maxWidth, (double)knownLines * lineHeight_());
+}
+
+void UIFileView::setScroll_(int axis, double v) {
+    if (bars.setOffset(layout_(), axis, v)) markDirty();
+}
+
+void UIFileView::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        if (e.user.code == 0xF001) { focused = true;  return; }
+        if (e.user.code == 0xF002) { focused = false; bars.cancelDrag(); return; }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
+    }
+    if (!enabled) return;
+    if (e.type == SDL_MOUSEWHEEL && !hovered) return;
+
+    const UIScrollBars::Layout l = layout_();
+    if (bars.handleMouse(e, l, (double)WHEEL_LINES * lineHeight_(),
+                         [this](int axis, double v) { setScroll_(axis, v); })) return;
+
+    if (!focused || e.type != SDL_KEYDOWN) return;
+    const double lh = lineHeight_(), page = std::max(lh, l.view.h - lh);
+    const double y = bars.offset(1), x = bars.offset(0);
+    switch (e.key.keysym.sym) {
+        case SDLK_UP:       setScroll_(1, y - lh); break;
+        case SDLK_DOWN:     setScroll_(1, y + lh); break;
+        case SDLK_PAGEUP:   setScroll_(1, y - page); break;
+        case SDLK_PAGEDOWN: setScroll_(1, y + page); break;
+        case SDLK_HOME:     setScroll_(1, 0.0); break;
+        case SDLK_END:      setScroll_(1, bars.maxOffset(l, 1)); break;
+        case SDLK_LEFT:     setScroll_(0, x - KEY_X_PX); break;
+        case SDLK_RIGHT:    setScroll_(0, x + KEY_X_PX); break;
+        default: break;
+    }
+}
+
+void UIFileView::render(SDL_Renderer* renderer) {
+    if (!visible) return;
+    const auto st = resolvedStyle<UITextAreaStyle>();
+    const UITheme& th = getTheme();
+    TTF_Font* f = activeFont_();
+
+    const LookStamp look = lookStamp();
+    if (look != seenLook) { seenLook = look; text.invalidateAll(); }
+
+    SDL_Color borderNow = focused ? st.borderFocus : (hovered ? st.borderHover : st.border);
+    if (st.borderPx > 0) {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, borderNow);
+        UIHelpers::FillRoundedRect(renderer, bounds.x + st.borderPx, bounds.y + st.borderPx,
+                                   bounds.w - 2*st.borderPx, bounds.h - 2*st.borderPx,
+                                   std::max(0, st.radius - st.borderPx), st.bg);
+    } else {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.bg);
+    }
+    if (!index || knownLines == 0 || !f) return;
+
+    const UIScrollBars::Layout l = layout_();
+    const SDL_Rect v = l.view;
+    const int lh = lineHeight_();
+    text.setCapacity((size_t)(v.h / lh) + 2);
+
+    SDL_Rect prevClip;
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer);
+    SDL_RenderGetClipRect(renderer, &prevClip);
+    SDL_Rect clip = v;
+    if (hadClip) SDL_IntersectRect(&prevClip, &v, &clip);
+    SDL_RenderSetClipRect(renderer, &clip);
+
+    SDL_Color fg = st.fg;
+    if (!enabled) fg.a = 160;
+    const Uint64 first = (Uint64)(bars.offset(1) / lh);
+    const int y0 = v.y - (int)(bars.offset(1) - (double)first * lh);
+    const int sx = (int)bars.offset(0);
+    for (Uint64 i = first; i < knownLines; ++i) {
+        const int y = y0 + (int)(i - first) * lh;
+        if (y >= v.y + v.h) break;
+        // Only a miss touches the mapping.
+        const auto t = text.get(renderer, f, fg, (size_t)i, MAX_LINE_PX, [&] {
+            const Uint64 s = lineStart_(i);
+            return displayText(index->file.data() + s, (size_t)(lineEnd_(s) - s));
+        });
+        if (t.w > maxWidth) maxWidth = t.w;
+        if (!t.texture || t.w <= sx) continue;
+        const int w = std::min(t.w - sx, v.w);
+        const SDL_Rect src{ sx, 0, w, t.h };
+        const SDL_Rect dst{ v.x, y, w, t.h };
+        SDL_RenderCopy(renderer, t.texture, &src, &dst);
+    }
+
+    SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
+    bars.render(renderer, l, th.sliderTrackColor, th.sliderThumbColor);
+}
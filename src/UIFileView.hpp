@@ -0,0 +1,101 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UIMappedFile.hpp"
+#include "UIScrollBars.hpp"
+#include "UITextRowCache.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Read-only viewer for files too large for UITextArea. The file is memory
+// mapped rather than read, and a background thread records where every 64th
+// line starts; the first screen is shown as soon as the first slice is
+// indexed and the scroll range grows as the rest comes in. A line is found
+// from the nearest checkpoint with at most 63 newline searches, and only the
+// lines in view are ever copied out and rasterized. Horizontal extent is the
+// widest line drawn so far.
+//
+// The view shows the file as it was when opened; appended lines appear only
+// after open() is called again. A file that shrinks or is replaced at its
+// path is re-opened at the same line within half a second. On POSIX systems
+// a truncation inside that window can still fault (SIGBUS) if the indexer or
+// a newly exposed line touches the lost pages.
+class UIFileView : public UIElement {
+public:
+    UIFileView(int x, int y, int w, int h);
+    ~UIFileView();
+
+    // Logs and returns false if the file cannot be mapped.
+    bool open(const std::string& path);
+    void close();
+    const std::string& path() const { return filePath; }
+    Uint64 fileSize() const { return index ? index->file.size() : 0; }
+
+    // Lines indexed so far; final once isIndexing() turns false.
+    Uint64 lineCount() const { return knownLines; }
+    bool isIndexing() const;
+    // Fraction of the file scanned, 0..1.
+    float indexProgress() const;
+
+    // Puts line (0-based) at the top. A line beyond the indexed part is
+    // remembered and scrolled to once the indexer reaches it.
+    void scrollToLine(Uint64 line);
+    Uint64 firstVisibleLine() const;
+    // Line containing the given byte; binary search over the checkpoints.
+    Uint64 lineAtOffset(Uint64 offset) const;
+    // Raw bytes of the line without its terminator, empty if not indexed.
+    std::string lineText(Uint64 line) const;
+
+    UIFileView* setFont(TTF_Font* f);
+
+    void handleEvent(const SDL_Event& e) override;
+    void update(float dt) override;
+    void render(SDL_Renderer* renderer) override;
+    bool isHovered() const override { return hovered; }
+    bool isFocusable() const override { return true; }
+
+private:
+    // Shared with the indexing job, which may outlive the widget by a slice.
+    struct Index {
+        static constexpr Uint64 STRIDE = 64;     // lines per checkpoint
+        static constexpr size_t BLOCK  = 4096;   // checkpoints per block
+
+        UIMappedFile file;
+        // Sized before the job starts and never resized; the job fills
+        // blocks in order and publishes them through `lines`.
+        std::vector<std::unique_ptr<Uint64[]>> blocks;
+        std::atomic<Uint64> lines{ 0 };
+        std::atomic<Uint64> scanned{ 0 };
+        std::atomic<bool> done{ false };
+        std::atomic<bool> cancel{ false };
+
+        Uint64 checkpoint(Uint64 k) const { return blocks[k / BLOCK][k % BLOCK]; }
+    };
+    static void build_(std::shared_ptr<Index> index);
+
+    std::shared_ptr<Index> index;
+    std::string filePath;
+    Uint64 knownLines = 0;           // snapshot of index->lines taken in update()
+    bool indexDone = true;
+    Uint64 pendingLine = (Uint64)-1;
+    int maxWidth = 0;
+
+    TTF_Font* font = nullptr;
+    UIScrollBars bars;
+    Uint32 lastStaleCheck = 0;
+    bool focused = false;
+    bool hovered = false;
+
+    UITextRowCache text;
+    LookStamp seenLook;
+
+    Uint64 lineStart_(Uint64 line) const;
+    Uint64 lineEnd_(Uint64 start) const;
+
+    TTF_Font* activeFont_() const;
+    int lineHeight_() const;
+    UIScrollBars::Layout layout_() const;
+    void setScroll_(int axis, double v);
+};
@@ -0,0 +1,62 @@
+#include "UIFrameClock.hpp"
+#include <algorithm>
+#include <cmath>
+
+UIFrameClock::UIFrameClock() {
+    reset();
+}
+
+void UIFrameClock::reset() {
+    freq_ = SDL_GetPerformanceFrequency();
+    if (freq_ == 0) freq_ = 1;
+    last_ = SDL_GetPerformanceCounter();
+    accumulator_ = 0.f;
+    history_.fill(0.f);
+    historyCount_ = 0;
+    historyHead_ = 0;
+    historySum_ = 0.0;
+    stats_ = Stats{};
+}
+
+float UIFrameClock::tick() {
+    const Uint64 now = SDL_GetPerformanceCounter();
+    float dt = (float)((double)(now - last_) / (double)freq_);
+    last_ = now;
+    if (dt < 0.f) dt = 0.f;
+    if (maxDelta_ > 0.f && dt > maxDelta_) dt = maxDelta_;
+
+    historySum_ -= history_[historyHead_];
+    history_[historyHead_] = dt;
+    historySum_ += dt;
+    historyHead_ = (historyHead_ + 1) % WINDOW;
+    if (historyCount_ < WINDOW) ++historyCount_;
+
+    stats_.dt = dt;
+    stats_.avgDt = (float)(historySum_ / historyCount_);
+    const auto first = history_.begin();
+    const auto [mn, mx] = std::minmax_element(first, first + historyCount_);
+    stats_.minDt = *mn;
+    stats_.maxDt = *mx;
+    stats_.fps = stats_.avgDt > 0.f ? 1.f / stats_.avgDt : 0.f;
+    ++stats_.frames;
+
+    if (fixedStep_ > 0.f) accumulator_ += dt;
+    return dt;
+}
+
+void UIFrameClock::setFixedStep(float seconds, int maxSteps) {
+    fixedStep_ = seconds > 0.f ? seconds : 0.f;
+    maxSteps_ = std::max(1, maxSteps);
+    accumulator_ = 0.f;
+}
+
+int UIFrameClock::takeFixedSteps() {
+    if (fixedStep_ <= 0.f) return 0;
+    int steps = 0;
+    while (accumulator_ >= fixedStep_ && steps < maxSteps_) {
+        accumulator_ -= fixedStep_;
+        ++steps;
+    }
+    if (accumulator_ >= fixedStep_) accumulator_ = std::fmod(accumulator_, fixedStep_);
+    return steps;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <array>
+
+// High-resolution frame timer. tick() once per frame; the returned delta is
+// clamped so a stall (breakpoint, window drag) does not turn into one huge step.
+class UIFrameClock {
+public:
+    struct Stats {
+        float  dt    = 0.f;   // last frame, seconds
+        float  avgDt = 0.f;   // over the last WINDOW frames
+        float  minDt = 0.f;
+        float  maxDt = 0.f;
+        float  fps   = 0.f;   // 1 / avgDt
+        Uint64 frames = 0;
+        // Reported by the UI: top-level elements drawn/culled in the last
+        // render and updated/skipped in the last update.
+        int drawn = 0, culled = 0;
+        int updated = 0, updateCulled = 0;
+    };
+
+    UIFrameClock();
+
+    float tick();
+    void  reset();
+
+    void  setElementCounts(int drawn, int culled, int updated, int updateCulled) {
+        stats_.drawn = drawn; stats_.culled = culled;
+        stats_.updated = updated; stats_.updateCulled = updateCulled;
+    }
+
+    float delta() const { return stats_.dt; }
+    const Stats& stats() const { return stats_; }
+
+    void  setMaxDelta(float seconds) { maxDelta_ = seconds > 0.f ? seconds : 0.f; }
+    float maxDelta() const { return maxDelta_; }
+
+    // Fixed-step accumulation: every tick() adds dt, takeFixedSteps() returns
+    // how many whole steps are due (at most maxSteps; the excess is dropped).
+    void  setFixedStep(float seconds, int maxSteps = 5);
+    float fixedStep() const { return fixedStep_; }
+    int   takeFixedSteps();
+    // Leftover fraction of a step, for interpolating between fixed states.
+    float fixedAlpha() const { return fixedStep_ > 0.f ? accumulator_ / fixedStep_ : 0.f; }
+
+private:
+    static constexpr int WINDOW = 120;
+
+    Uint64 freq_ = 1;
+    Uint64 last_ = 0;
+    float  maxDelta_ = 0.25f;
+
+    float fixedStep_ = 0.f;
+    int   maxSteps_ = 5;
+    float accumulator_ = 0.f;
+
+    std::array<float, WINDOW> history_{};
+    int   historyCount_ = 0;
+    int   historyHead_ = 0;
+    double historySum_ = 0.0;
+    Stats stats_;
+};
@@ -7,8 +7,33 @@ UIGroupBox::UIGroupBox(const std::string& title, int x, int y, int w, int h)
     font = getThemeFont(getTheme());
 }
 
+UIGroupBox::~UIGroupBox() {
+    for (auto& child : children)
+        if (child && child->parent() == this) child->setParent(nullptr);
+}
+
 void UIGroupBox::addChild(std::shared_ptr<UIElement> child) {
+    if (child) {
+        child->attachTimers(timers);
+        child->setParent(this);
+    }
     children.push_back(child);
+    markDirty();
+}
+
+void UIGroupBox::markDirty() {
+    layer.invalidate();
+    UIElement::markDirty();
+}
+
+void UIGroupBox::setLayerCached(bool on) {
+    layer.setEnabled(on);
+}
+
+void UIGroupBox::attachTimers(UITimerWheel* wheel) {
+    UIElement::attachTimers(wheel);
+    for (auto& child : children)
+        if (child) child->attachTimers(wheel);
 }
 
 const std::vector<std::shared_ptr<UIElement>>& UIGroupBox::getChildren() const {
@@ -16,19 +41,26 @@ const std::vector<std::shared_ptr<UIElement>>& UIGroupBox::getChildren() const {
 }
 
 void UIGroupBox::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT && (e.user.code == 0xF003 || e.user.code == 0xF004)) return;
     for (auto& child : children)
         child->handleEvent(e);
 }
 
 void UIGroupBox::update(float dt) {
     for (auto& child : children)
-        child->update(dt);
+        if (child->wantsFrameUpdate()) child->update(dt);
 }
 
 void UIGroupBox::render(SDL_Renderer* renderer) {
+    if (layer.render(renderer, bounds, UIConfig::lookGeneration(),
+                     [this](SDL_Renderer* r) { paint_(r); }))
+        return;
+    paint_(renderer);
+}
+
+void UIGroupBox::paint_(SDL_Renderer* renderer) {
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeGroupBoxStyle(th, ds);
+    const auto st = resolvedStyle<UIGroupBoxStyle>();
 
     TTF_Font* fnt = font ? font : (th.font ? th.font : UIConfig::getDefaultFont());
     if (!fnt) return;
@@ -1,5 +1,6 @@
 #pragma once
 #include "UIElement.hpp"
+#include "UILayerCache.hpp"
 #include <vector>
 #include <memory>
 #include <string>
@@ -7,6 +8,7 @@
 class UIGroupBox : public UIElement {
 public:
     UIGroupBox(const std::string& title, int x, int y, int w, int h);
+    ~UIGroupBox() override;
 
     void addChild(std::shared_ptr<UIElement> child);
     const std::vector<std::shared_ptr<UIElement>>& getChildren() const;
@@ -14,9 +16,23 @@ public:
     void handleEvent(const SDL_Event& e) override;
     void update(float dt) override;
     void render(SDL_Renderer* renderer) override;
+    void attachTimers(UITimerWheel* wheel) override;
+    void markDirty() override;
+
+    // Opt-in: render the box and its children once into a texture and reuse
+    // it until a child reports damage. Best for mostly static groups.
+    // Children report through markDirty() from input, timers and setters,
+    // and from update() when a value bound by reference changed; a custom
+    // child that draws state changed any other way must call markDirty().
+    void setLayerCached(bool on);
+    bool isLayerCached() const { return layer.isEnabled(); }
+    const UILayerCache& layerCache() const { return layer; }
 
 private:
     std::string title;
     std::vector<std::shared_ptr<UIElement>> children;
     TTF_Font* font = nullptr;
+    UILayerCache layer;
+
+    void paint_(SDL_Renderer* renderer);
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <SDL2/SDL.h>
+#include <array>
 #include <cmath>
 #include <memory>
 #include <algorithm>
@@ -17,10 +18,33 @@ namespace UIHelpers {
     }
     inline SDL_Color WithAlpha(SDL_Color c, Uint8 a) { c.a = a; return c; }
     void DrawShadowRoundedRect(SDL_Renderer* r, const SDL_Rect& rect, int radius, int offset, Uint8 alpha);
-    inline float RelativeLuma(SDL_Color c) {
-        auto lin = [](float u){ u/=255.0f; return (u<=0.04045f)? u/12.92f : powf((u+0.055f)/1.055f, 2.4f); };
-        float R = lin(c.r), G = lin(c.g), B = lin(c.b);
-        return 0.2126f*R + 0.7152f*G + 0.0722f*B;
+    namespace detail {
+        // constexpr pow(b, 2.4) for b in (0, 1] as 1 / exp(-2.4 * ln b).
+        constexpr double ConstLn(double b) {
+            const double z = (b - 1.0) / (b + 1.0), z2 = z * z;
+            double term = z, sum = 0.0;
+            for (int k = 1; k < 400; k += 2) { sum += term / k; term *= z2; }
+            return 2.0 * sum;
+        }
+        constexpr double ConstExpNeg(double y) {
+            double term = 1.0, sum = 1.0;
+            for (int k = 1; k < 80; ++k) { term *= y / k; sum += term; }
+            return 1.0 / sum;
+        }
+        constexpr std::array<float, 256> MakeSrgbToLinear() {
+            std::array<float, 256> t{};
+            for (int i = 0; i < 256; ++i) {
+                const double u = i / 255.0;
+                t[i] = (u <= 0.04045) ? float(u / 12.92)
+                                      : float(ConstExpNeg(-2.4 * ConstLn((u + 0.055) / 1.055)));
+            }
+            return t;
+        }
+    }
+    inline constexpr std::array<float, 256> SrgbToLinear = detail::MakeSrgbToLinear();
+
+    constexpr float RelativeLuma(SDL_Color c) {
+        return 0.2126f*SrgbToLinear[c.r] + 0.7152f*SrgbToLinear[c.g] + 0.0722f*SrgbToLinear[c.b];
     }
     inline SDL_Color Lighten(SDL_Color c, int delta) { return AdjustBrightness(c, +std::abs(delta)); }
     inline SDL_Color Darken (SDL_Color c, int delta) { return AdjustBrightness(c, -std::abs(delta)); }
@@ -0,0 +1,83 @@
+#include "UIImage.hpp"
+#include <algorithm>
+
+UIImage::UIImage(int x, int y, int w, int h, const std::string& p) {
+    bounds = { x, y, w, h };
+    setPath(p);
+}
+
+UIImage* UIImage::setPath(const std::string& p) {
+    if (p == path && image) return this;
+    path = p;
+    reacquire_();
+    return this;
+}
+
+UIImage* UIImage::setMaxDecodeSize(int px) {
+    px = std::max(0, px);
+    if (px == maxDecode) return this;
+    maxDecode = px;
+    reacquire_();
+    return this;
+}
+
+void UIImage::reacquire_() {
+    image = path.empty() ? nullptr : UIImageCache::acquire(path, maxDecode);
+    seenState = -1;
+    markDirty();
+}
+
+// The decoder finishes on its own thread; pick up the change here.
+void UIImage::update(float) {
+    const int s = image ? (int)image->state() : -1;
+    if (s != seenState) {
+        seenState = s;
+        markDirty();
+    }
+}
+
+void UIImage::render(SDL_Renderer* renderer) {
+    if (!visible) return;
+    const auto st = resolvedStyle<UIImageStyle>();
+
+    const int iw = isReady() ? image->width() : 0, ih = isReady() ? image->height() : 0;
+    if (iw <= 0 || ih <= 0) {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.placeholder);
+        if (hasFailed()) {
+            const float cx = bounds.x + bounds.w * 0.5f, cy = bounds.y + bounds.h * 0.5f;
+            const float r = std::min(bounds.w, bounds.h) * 0.15f;
+            UIHelpers::DrawRoundStrokeLine(renderer, cx - r, cy - r, cx + r, cy + r, 2.f, st.placeholderFg);
+            UIHelpers::DrawRoundStrokeLine(renderer, cx - r, cy + r, cx + r, cy - r, 2.f, st.placeholderFg);
+        }
+        return;
+    }
+
+    // dst in widget space, src in level-0 pixels.
+    SDL_Rect dst = bounds;
+    SDL_FRect src{ 0.f, 0.f, (float)iw, (float)ih };
+    const float sx = (float)bounds.w / iw, sy = (float)bounds.h / ih;
+    if (fit == UIImageFit::Contain) {
+        const float s = std::min(sx, sy);
+        dst.w = std::max(1, (int)(iw * s));
+        dst.h = std::max(1, (int)(ih * s));
+        dst.x = bounds.x + (bounds.w - dst.w) / 2;
+        dst.y = bounds.y + (bounds.h - dst.h) / 2;
+    } else if (fit == UIImageFit::Cover) {
+        const float s = std::max(sx, sy);
+        src.w = bounds.w / s;
+        src.h = bounds.h / s;
+        src.x = (iw - src.w) * 0.5f;
+        src.y = (ih - src.h) * 0.5f;
+    }
+
+    // Pick the level by the size it is actually drawn at.
+    const int needW = (int)(dst.w * (iw / src.w)), needH = (int)(dst.h * (ih / src.h));
+    float scale = 1.f;
+    SDL_Texture* tex = image->texture(renderer, needW, needH, &scale);
+    if (!tex) return;
+    const SDL_Rect srcPx{ (int)(src.x * scale), (int)(src.y * scale),
+                          std::max(1, (int)(src.w * scale)), std::max(1, (int)(src.h * scale)) };
+    if (!enabled) SDL_SetTextureAlphaMod(tex, 140);
+    SDL_RenderCopy(renderer, tex, &srcPx, &dst);
+    if (!enabled) SDL_SetTextureAlphaMod(tex, 255);
+}
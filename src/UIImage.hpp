@@ -0,0 +1,39 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UIImageCache.hpp"
+#include <string>
+
+enum class UIImageFit { Contain, Cover, Stretch };
+
+// Shows an image file. Decoding happens off the UI thread; until it is done
+// (or if it fails) a placeholder is drawn. Widgets showing the same file at
+// the same decode size share one cache entry.
+class UIImage : public UIElement {
+public:
+    UIImage(int x, int y, int w, int h, const std::string& path = std::string());
+
+    UIImage* setPath(const std::string& path);
+    const std::string& getPath() const { return path; }
+    // Decode at most this many pixels on the longer side (0 = full size);
+    // use the thumbnail's size for grids.
+    UIImage* setMaxDecodeSize(int px);
+    UIImage* setFit(UIImageFit f) { fit = f; markDirty(); return this; }
+
+    bool isReady() const { return image && image->state() == UIImageCache::Entry::Ready; }
+    bool hasFailed() const { return image && image->state() == UIImageCache::Entry::Failed; }
+    // Decoded size, {0, 0} until ready.
+    SDL_Point imageSize() const { return isReady() ? SDL_Point{ image->width(), image->height() } : SDL_Point{ 0, 0 }; }
+
+    void handleEvent(const SDL_Event&) override {}
+    void update(float dt) override;
+    void render(SDL_Renderer* renderer) override;
+
+private:
+    std::string path;
+    int maxDecode = 0;
+    UIImageFit fit = UIImageFit::Contain;
+    UIImageCache::Handle image;
+    int seenState = -1;
+
+    void reacquire_();
+};
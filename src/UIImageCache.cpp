@@ -0,0 +1,159 @@
+#include "UIImageCache.hpp"
+#include "UIWorker.hpp"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <unordered_map>
+
+static constexpr int MIN_LEVEL_PX = 16;
+
+// UI thread only. Expired entries are swept on acquire, so dropping a
+// handle never touches the map.
+static std::unordered_map<std::string, std::weak_ptr<UIImageCache::Entry>>& entries() {
+    static std::unordered_map<std::string, std::weak_ptr<UIImageCache::Entry>> map;
+    return map;
+}
+
+// Kept apart from UIWorker::shared() so a folder of thumbnails does not
+// queue ahead of table sorts.
+static UIWorker& decoder() {
+    static UIWorker worker;
+    return worker;
+}
+
+// 2x2 box filter on ARGB8888; odd edges reuse the last row/column.
+static UIHelpers::UniqueSurface halve(SDL_Surface* src) {
+    const int w = std::max(1, src->w / 2), h = std::max(1, src->h / 2);
+    auto dst = UIHelpers::MakeSurface(SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888));
+    if (!dst) return dst;
+    for (int y = 0; y < h; ++y) {
+        const int y0 = std::min(2*y, src->h - 1), y1 = std::min(2*y + 1, src->h - 1);
+        const Uint32* r0 = (const Uint32*)((const Uint8*)src->pixels + y0 * src->pitch);
+        const Uint32* r1 = (const Uint32*)((const Uint8*)src->pixels + y1 * src->pitch);
+        Uint32* out = (Uint32*)((Uint8*)dst->pixels + y * dst->pitch);
+        for (int x = 0; x < w; ++x) {
+            const int x0 = std::min(2*x, src->w - 1), x1 = std::min(2*x + 1, src->w - 1);
+            const Uint32 a = r0[x0], b = r0[x1], c = r1[x0], d = r1[x1];
+            Uint32 px = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                const Uint32 sum = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF) +
+                                   ((c >> shift) & 0xFF) + ((d >> shift) & 0xFF);
+                px |= ((sum + 2) >> 2) << shift;
+            }
+            out[x] = px;
+        }
+    }
+    return dst;
+}
+
+UIImageCache::Handle UIImageCache::acquire(const std::string& path, int maxDim) {
+    auto& map = entries();
+    const std::string key = path + '\n' + std::to_string(std::max(0, maxDim));
+    auto it = map.find(key);
+    if (it != map.end()) {
+        if (Handle h = it->second.lock()) return h;
+    }
+    if (map.size() > 64) {
+        for (auto i = map.begin(); i != map.end();) i = i->second.expired() ? map.erase(i) : std::next(i);
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->path_ = path;
+    entry->maxDim = std::max(0, maxDim);
+    map[key] = entry;
+    std::weak_ptr<Entry> weak = entry;
+    decoder().post([out = entry->decoded, weak, path, maxDim = entry->maxDim] { decode_(out, weak, path, maxDim); });
+    return entry;
+}
+
+size_t UIImageCache::liveEntries() {
+    size_t n = 0;
+    for (const auto& kv : entries()) n += kv.second.expired() ? 0 : 1;
+    return n;
+}
+
+// Runs on the decoder thread. Nothing here touches a renderer, and the
+// entry is only checked for expiry, never locked, so its textures cannot end
+// up destroyed here.
+void UIImageCache::decode_(std::shared_ptr<Entry::Decoded> out, std::weak_ptr<Entry> weak,
+                           std::string path, int maxDim) {
+    if (weak.expired()) return;   // every widget let go before we got to it
+
+    auto fail = [&](const char* what) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIImage: %s '%s': %s", what, path.c_str(), IMG_GetError());
+        out->state.store(Entry::Failed, std::memory_order_release);
+        UIWorker::wakeUI();
+    };
+
+    SDL_RWops* rw = SDL_RWFromFile(path.c_str(), "rb");
+    if (!rw) { fail("cannot open"); return; }
+    auto raw = UIHelpers::MakeSurface(IMG_Load_RW(rw, 1));
+    if (!raw) { fail("cannot decode"); return; }
+    auto img = UIHelpers::MakeSurface(SDL_ConvertSurfaceFormat(raw.get(), SDL_PIXELFORMAT_ARGB8888, 0));
+    raw.reset();
+    if (!img) { fail("cannot convert"); return; }
+
+    // Thumbnails: halve while that stays above the target, then one scaled blit.
+    if (maxDim > 0) {
+        while (std::max(img->w, img->h) / 2 >= maxDim) {
+            auto half = halve(img.get());
+            if (!half) break;
+            img = std::move(half);
+        }
+        const int longSide = std::max(img->w, img->h);
+        if (longSide > maxDim) {
+            const int w = std::max(1, img->w * maxDim / longSide), h = std::max(1, img->h * maxDim / longSide);
+            auto scaled = UIHelpers::MakeSurface(SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888));
+            if (scaled) {
+                SDL_SetSurfaceBlendMode(img.get(), SDL_BLENDMODE_NONE);
+                if (SDL_BlitScaled(img.get(), nullptr, scaled.get(), nullptr) == 0) img = std::move(scaled);
+            }
+        }
+    }
+
+    std::vector<Entry::Level> levels;
+    levels.emplace_back();
+    levels.back().w = img->w;
+    levels.back().h = img->h;
+    levels.back().surface = std::move(img);
+    while (std::min(levels.back().w, levels.back().h) / 2 >= MIN_LEVEL_PX) {
+        if (weak.expired()) return;
+        auto half = halve(levels.back().surface.get());
+        if (!half) break;
+        Entry::Level l;
+        l.w = half->w;
+        l.h = half->h;
+        l.surface = std::move(half);
+        levels.push_back(std::move(l));
+    }
+
+    if (weak.expired()) return;
+    out->levels = std::move(levels);
+    out->state.store(Entry::Ready, std::memory_order_release);
+    UIWorker::wakeUI();
+}
+
+SDL_Texture* UIImageCache::Entry::texture(SDL_Renderer* r, int w, int h, float* scale) {
+    if (state() != Ready || !r) return nullptr;
+    const std::vector<Level>& levels = decoded->levels;
+    if (levels.empty()) return nullptr;
+    if (renderer != r || textures.size() != levels.size()) {
+        textures.clear();
+        textures.resize(levels.size());
+        renderer = r;
+    }
+    size_t pick = 0;
+    while (pick + 1 < levels.size() && levels[pick + 1].w >= w && levels[pick + 1].h >= h) ++pick;
+    const Level& l = levels[pick];
+    UIHelpers::UniqueTexture& tex = textures[pick];
+    if (!tex) {
+        tex = UIHelpers::MakeTexture(SDL_CreateTextureFromSurface(r, l.surface.get()));
+        if (!tex) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIImage: upload of '%s' failed: %s", path_.c_str(), SDL_GetError());
+            return nullptr;
+        }
+        SDL_SetTextureBlendMode(tex.get(), SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(tex.get(), SDL_ScaleModeLinear);
+    }
+    if (scale) *scale = (float)l.w / (float)levels[0].w;
+    return tex.get();
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "UIHelpers.hpp"
+
+// Decoded images shared between UIImage widgets, keyed by path and decode
+// size. Files are decoded on a background thread with SDL2_image and a chain
+// of half-size levels is built next to the full image; the UI thread uploads
+// a level the first time something is drawn at that size and keeps it, so
+// an image scrolled out of view and back is not uploaded again. An entry
+// lives as long as some widget holds its handle. The decoder never holds an
+// entry, only the texture-free Decoded it fills in, so textures are destroyed
+// on whichever thread drops the last handle: the UI thread, for widgets.
+class UIImageCache {
+public:
+    class Entry {
+    public:
+        enum State { Loading, Ready, Failed };
+        State state() const { return (State)decoded->state.load(std::memory_order_acquire); }
+        // Size of the decoded image (level 0); valid once Ready.
+        int width() const { return state() == Ready ? decoded->levels[0].w : 0; }
+        int height() const { return state() == Ready ? decoded->levels[0].h : 0; }
+        const std::string& path() const { return path_; }
+
+        // Smallest level that still covers w x h, uploaded on first use.
+        // *scale is the level's size relative to level 0.
+        SDL_Texture* texture(SDL_Renderer* r, int w, int h, float* scale);
+
+    private:
+        friend class UIImageCache;
+        struct Level {
+            UIHelpers::UniqueSurface surface;
+            int w = 0, h = 0;
+        };
+        // Shared with the decode job; surfaces only, so it may die on either thread.
+        struct Decoded {
+            std::atomic<int> state{ Loading };
+            std::vector<Level> levels;       // written by the decoder before Ready
+        };
+        std::string path_;
+        int maxDim = 0;
+        std::shared_ptr<Decoded> decoded = std::make_shared<Decoded>();
+        std::vector<UIHelpers::UniqueTexture> textures;   // per level, UI thread
+        SDL_Renderer* renderer = nullptr;
+    };
+    using Handle = std::shared_ptr<Entry>;
+
+    // maxDim > 0 decodes a downscaled copy whose longer side is at most maxDim.
+    static Handle acquire(const std::string& path, int maxDim = 0);
+    static size_t liveEntries();
+
+private:
+    static void decode_(std::shared_ptr<Entry::Decoded> out, std::weak_ptr<Entry> entry,
+                        std::string path, int maxDim);
+};
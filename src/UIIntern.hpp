@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+// Deduplicating store for small immutable values (themes, styles). Equal
+// values share one reference-counted node; UIInterned<T> is the handle. T
+// needs operator== and a free HashValue(const T&). Not thread-safe: use on
+// the UI thread.
+template<class T>
+class UIInterned {
+public:
+    UIInterned() = default;
+    explicit UIInterned(const T& value) : node_(acquire_(value)) {}
+    UIInterned(const UIInterned& o) : node_(o.node_) { if (node_) ++node_->refs; }
+    UIInterned(UIInterned&& o) noexcept : node_(o.node_) { o.node_ = nullptr; }
+    UIInterned& operator=(UIInterned o) noexcept { std::swap(node_, o.node_); return *this; }
+    ~UIInterned() { release_(node_); }
+
+    explicit operator bool() const { return node_ != nullptr; }
+    const T& operator*() const { return node_->value; }
+    const T* operator->() const { return &node_->value; }
+    const T* get() const { return node_ ? &node_->value : nullptr; }
+    // Unique per node and never reused, so it can key caches derived from the value.
+    std::uint64_t generation() const { return node_ ? node_->generation : 0; }
+    void reset() { release_(node_); node_ = nullptr; }
+
+    // Identity comparison; equal values always intern to the same node.
+    bool operator==(const UIInterned& o) const { return node_ == o.node_; }
+    bool operator!=(const UIInterned& o) const { return node_ != o.node_; }
+
+    static size_t liveCount() { return table_().size(); }
+    // Shared with non-interned sources of T (UIConfig defaults) so their
+    // generations never collide with a node's.
+    static std::uint64_t nextGeneration() { return ++nextGen_; }
+
+private:
+    struct Node {
+        T value;
+        size_t hash;
+        size_t refs;
+        std::uint64_t generation;
+    };
+    Node* node_ = nullptr;
+    static inline std::uint64_t nextGen_ = 0;
+
+    // Never destroyed: elements owned by other statics may release their
+    // handles during exit after this would have been torn down.
+    static std::unordered_multimap<size_t, Node*>& table_() {
+        static auto* t = new std::unordered_multimap<size_t, Node*>();
+        return *t;
+    }
+
+    static Node* acquire_(const T& value) {
+        auto& t = table_();
+        const size_t h = HashValue(value);
+        auto [first, last] = t.equal_range(h);
+        for (auto it = first; it != last; ++it) {
+            if (it->second->value == value) { ++it->second->refs; return it->second; }
+        }
+        Node* n = new Node{value, h, 1, nextGeneration()};
+        t.emplace(h, n);
+        return n;
+    }
+
+    static void release_(Node* n) {
+        if (!n || --n->refs) return;
+        auto& t = table_();
+        auto [first, last] = t.equal_range(n->hash);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == n) { t.erase(it); break; }
+        }
+        delete n;
+    }
+};
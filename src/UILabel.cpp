@@ -11,44 +11,35 @@ UILabel::UILabel(const std::string& text, int x, int y, int w, int h, TTF_Font*
 
 void UILabel::invalidateCache() const {
     cachedTexture.reset();
-    cachedText.clear();
-    cachedColor = {0, 0, 0, 0};
-    cachedFont = nullptr;
+    cachedLook = {};
     cachedWidth = 0;
     cachedHeight = 0;
 }
 
 void UILabel::render(SDL_Renderer* renderer) {
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeLabelStyle(th, ds);
-    TTF_Font* activeFont = font ? font : getThemeFont(th);
-    if (!activeFont) return;
+    const LookStamp look = lookStamp();
+    if (!cachedTexture || cachedLook != look) {
+        invalidateCache();
 
-    SDL_Color txtCol = (color.a != 0) ? color : st.fg;
+        const UITheme& th = getTheme();
+        const auto st = resolvedStyle<UILabelStyle>();
+        TTF_Font* activeFont = font ? font : getThemeFont(th);
+        if (!activeFont) return;
+
+        SDL_Color txtCol = (color.a != 0) ? color : st.fg;
 
-    bool needsRebuild = !cachedTexture || 
-                        cachedText != text || 
-                        cachedFont != activeFont ||
-                        std::memcmp(&cachedColor, &txtCol, sizeof(SDL_Color)) != 0;
-    
-    if (needsRebuild) {
-        invalidateCache();
-        
         auto surface = UIHelpers::MakeSurface(
             TTF_RenderUTF8_Blended(activeFont, text.c_str(), txtCol)
         );
-        
+
         if (!surface) return;
-        
+
         cachedTexture = UIHelpers::MakeTexture(
             SDL_CreateTextureFromSurface(renderer, surface.get())
         );
         if (!cachedTexture) return;
-        
-        cachedText = text;
-        cachedColor = txtCol;
-        cachedFont = activeFont;
+
+        cachedLook = look;
         cachedWidth = surface->w;
         cachedHeight = surface->h;
     }
@@ -67,6 +58,7 @@ UILabel* UILabel::setColor(SDL_Color c) {
     if (std::memcmp(&color, &c, sizeof(SDL_Color)) != 0) {
         color = c;
         invalidateCache();
+        markDirty();
     }
     return this;
 }
@@ -79,5 +71,6 @@ void UILabel::setText(const std::string& newText) {
     if (text != newText) {
         text = newText;
         invalidateCache();
+        markDirty();
     }
 }
\ No newline at end of file
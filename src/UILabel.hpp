@@ -11,6 +11,7 @@ public:
     
     void render(SDL_Renderer* renderer) override;
     void update(float dt) override { (void)dt; }
+    bool wantsFrameUpdate() const override { return false; }
     void handleEvent(const SDL_Event& e) override { (void)e; }
 
     UILabel* setColor(SDL_Color newColor);
@@ -25,9 +26,7 @@ private:
     SDL_Color color = {255, 255, 255, 255};
     
     mutable UIHelpers::UniqueTexture cachedTexture;
-    mutable std::string cachedText;
-    mutable SDL_Color cachedColor{0, 0, 0, 0};
-    mutable TTF_Font* cachedFont = nullptr;
+    mutable LookStamp cachedLook;
     mutable int cachedWidth = 0;
     mutable int cachedHeight = 0;
     
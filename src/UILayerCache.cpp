@@ -0,0 +1,122 @@
+#include "UILayerCache.hpp"
+
+void UILayerCache::setEnabled(bool on) {
+    if (enabled_ == on) return;
+    enabled_ = on;
+    if (!on) release();
+    dirty_ = true;
+}
+
+void UILayerCache::invalidate(const SDL_Rect& r) {
+    if (dirty_ || r.w <= 0 || r.h <= 0) return;
+    if (damage_.w <= 0 || damage_.h <= 0) damage_ = r;
+    else SDL_UnionRect(&damage_, &r, &damage_);
+}
+
+void UILayerCache::release() {
+    if (!tex_) return;
+    tex_.reset();
+    totalBytes_ -= bytes_;
+    --liveLayers_;
+    bytes_ = 0;
+    w_ = h_ = 0;
+    renderer_ = nullptr;
+    dirty_ = true;
+}
+
+bool UILayerCache::create_(SDL_Renderer* r, int w, int h) {
+    tex_ = UIHelpers::MakeTexture(
+        SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h));
+    if (!tex_) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UILayerCache: render target %dx%d failed, disabling: %s",
+                    w, h, SDL_GetError());
+        enabled_ = false;
+        return false;
+    }
+    // Painting with BLEND into a cleared target yields premultiplied color.
+    const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(tex_.get(), premultiplied) != 0)
+        SDL_SetTextureBlendMode(tex_.get(), SDL_BLENDMODE_BLEND);
+
+    renderer_ = r;
+    w_ = w; h_ = h;
+    bytes_ = (size_t)w * (size_t)h * 4;
+    totalBytes_ += bytes_;
+    ++liveLayers_;
+    dirty_ = true;
+    return true;
+}
+
+bool UILayerCache::render(SDL_Renderer* r, const SDL_Rect& area, Uint64 lookGen,
+                          const std::function<void(SDL_Renderer*)>& paint) {
+    if (!refresh(r, area, lookGen, paint)) return false;
+    SDL_RenderCopy(r, tex_.get(), nullptr, &area);
+    return true;
+}
+
+bool UILayerCache::refresh(SDL_Renderer* r, const SDL_Rect& area, Uint64 lookGen,
+                           const std::function<void(SDL_Renderer*)>& paint) {
+    if (!enabled_ || !r || area.w <= 0 || area.h <= 0) return false;
+    if (!SDL_RenderTargetSupported(r)) return false;
+    float sx = 1.f, sy = 1.f;
+    SDL_RenderGetScale(r, &sx, &sy);
+    if (sx != 1.f || sy != 1.f) return false;
+
+    if (tex_ && (area.w != w_ || area.h != h_ || r != renderer_)) release();
+    if (!tex_ && !create_(r, area.w, area.h)) return false;
+
+    if (area.x != x_ || area.y != y_ || lookGen != lookGen_ || epochSeen_ != epoch_) dirty_ = true;
+
+    SDL_Rect region = area;
+    const bool partial = !dirty_ && damage_.w > 0 && damage_.h > 0 &&
+                         SDL_IntersectRect(&damage_, &area, &region);
+    damage_ = { 0, 0, 0, 0 };
+
+    if (dirty_ || partial) {
+        SDL_Texture* prevTarget = SDL_GetRenderTarget(r);
+        SDL_Rect prevViewport, prevClip;
+        SDL_RenderGetViewport(r, &prevViewport);
+        SDL_RenderGetClipRect(r, &prevClip);
+        const bool prevClipOn = SDL_RenderIsClipEnabled(r);
+        Uint8 cr, cg, cb, ca;
+        SDL_GetRenderDrawColor(r, &cr, &cg, &cb, &ca);
+        SDL_BlendMode prevBlend;
+        SDL_GetRenderDrawBlendMode(r, &prevBlend);
+
+        if (SDL_SetRenderTarget(r, tex_.get()) != 0) {
+            release();
+            enabled_ = false;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UILayerCache: disabled: %s", SDL_GetError());
+            return false;
+        }
+        // Children draw in window coordinates; shift them onto the texture.
+        const SDL_Rect shifted{ -area.x, -area.y, area.x + area.w, area.y + area.h };
+        SDL_RenderSetViewport(r, &shifted);
+        SDL_RenderSetClipRect(r, &region);
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+        // RenderClear ignores the clip, so a partial repaint clears by fill.
+        if (dirty_) SDL_RenderClear(r);
+        else SDL_RenderFillRect(r, &region);
+        SDL_SetRenderDrawBlendMode(r, prevBlend);
+        SDL_SetRenderDrawColor(r, cr, cg, cb, ca);
+
+        paintRect_ = region;
+        paint(r);
+
+        SDL_SetRenderTarget(r, prevTarget);
+        SDL_RenderSetViewport(r, &prevViewport);
+        SDL_RenderSetClipRect(r, prevClipOn ? &prevClip : nullptr);
+        SDL_SetRenderDrawBlendMode(r, prevBlend);
+        SDL_SetRenderDrawColor(r, cr, cg, cb, ca);
+
+        x_ = area.x; y_ = area.y;
+        lookGen_ = lookGen;
+        epochSeen_ = epoch_;
+        dirty_ = false;
+        ++repaints_;
+    }
+    return true;
+}
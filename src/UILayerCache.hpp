@@ -0,0 +1,65 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <functional>
+#include "UIHelpers.hpp"
+
+// Render-target cache for a container subtree ("cache as bitmap"). While
+// enabled, render() repaints into an offscreen texture only when the layer
+// is dirty and otherwise just composites the texture. Content outside the
+// container's bounds is clipped. The texture is dropped when the area
+// changes size or the layer is disabled.
+class UILayerCache {
+public:
+    UILayerCache() = default;
+    ~UILayerCache() { release(); }
+    UILayerCache(const UILayerCache&) = delete;
+    UILayerCache& operator=(const UILayerCache&) = delete;
+
+    void setEnabled(bool on);
+    bool isEnabled() const { return enabled_; }
+    void invalidate() { dirty_ = true; }
+    // Repaints only r (same coordinates as the area) on the next refresh.
+    // Damage accumulates as one bounding rect until then.
+    void invalidate(const SDL_Rect& r);
+    // While paint runs: the part of the area being repainted. The clip is
+    // set to it and painters may skip anything outside.
+    const SDL_Rect& paintRect() const { return paintRect_; }
+    void release();
+
+    // Returns false if the layer is off or unsupported by the renderer;
+    // the caller then paints directly. lookGen forces a repaint when it changes.
+    bool render(SDL_Renderer* r, const SDL_Rect& area, Uint64 lookGen,
+                const std::function<void(SDL_Renderer*)>& paint);
+    // render() without the final composite, for callers that blit part of it.
+    bool refresh(SDL_Renderer* r, const SDL_Rect& area, Uint64 lookGen,
+                 const std::function<void(SDL_Renderer*)>& paint);
+    SDL_Texture* texture() const { return tex_.get(); }
+
+    size_t bytes() const { return bytes_; }
+    Uint64 repaints() const { return repaints_; }
+
+    static size_t totalBytes() { return totalBytes_; }
+    static int    liveLayers() { return liveLayers_; }
+    // Render targets lose their contents on SDL_RENDER_TARGETS_RESET.
+    static void   invalidateAll() { ++epoch_; }
+
+private:
+    bool create_(SDL_Renderer* r, int w, int h);
+
+    UIHelpers::UniqueTexture tex_;
+    SDL_Renderer* renderer_ = nullptr;
+    int w_ = 0, h_ = 0;
+    int x_ = 0, y_ = 0;
+    Uint64 lookGen_ = 0;
+    Uint64 epochSeen_ = 0;
+    size_t bytes_ = 0;
+    Uint64 repaints_ = 0;
+    bool enabled_ = false;
+    bool dirty_ = true;
+    SDL_Rect damage_{ 0, 0, 0, 0 };
+    SDL_Rect paintRect_{ 0, 0, 0, 0 };
+
+    static inline size_t totalBytes_ = 0;
+    static inline int    liveLayers_ = 0;
+    static inline Uint64 epoch_ = 0;
+};
@@ -0,0 +1,210 @@
+#include "UIListBox.hpp"
+#include <algorithm>
+
+static constexpr int WHEEL_ROWS    = 3;
+static constexpr int ROW_PAD_Y     = 8;
+
+UIListBox::UIListBox(int x, int y, int w, int h) {
+    bounds = { x, y, w, h };
+}
+
+UIListBox* UIListBox::setModel(CountFn count, ItemFn item) {
+    ownedItems.clear();
+    countFn = std::move(count);
+    itemFn = std::move(item);
+    invalidateItems();
+    return this;
+}
+
+UIListBox* UIListBox::setItems(std::vector<std::string> items) {
+    ownedItems = std::move(items);
+    countFn = [this] { return ownedItems.size(); };
+    itemFn = [this](size_t i) { return ownedItems[i]; };
+    invalidateItems();
+    return this;
+}
+
+void UIListBox::invalidateItems() {
+    count_ = countFn ? countFn() : 0;
+    if (selected_ != npos && selected_ >= count_) selected_ = npos;
+    if (hoverIdx != npos && hoverIdx >= count_) hoverIdx = npos;
+    rows.invalidateAll();
+    setScroll_(bars.offset(1));
+    markDirty();
+}
+
+void UIListBox::invalidateItem(size_t index) {
+    rows.invalidate(index);
+    markDirty();
+}
+
+UIListBox* UIListBox::setFont(TTF_Font* f) {
+    font = f;
+    setScroll_(bars.offset(1));
+    markDirty();
+    return this;
+}
+
+UIListBox* UIListBox::setRowHeight(int px) {
+    rowH = std::max(0, px);
+    setScroll_(bars.offset(1));
+    markDirty();
+    return this;
+}
+
+TTF_Font* UIListBox::activeFont_() const {
+    if (font) return font;
+    const UITheme& th = getTheme();
+    return th.font ? th.font : UIConfig::getDefaultFont();
+}
+
+int UIListBox::rowHeight() const {
+    if (rowH > 0) return rowH;
+    TTF_Font* f = activeFont_();
+    return f ? TTF_FontHeight(f) + ROW_PAD_Y : 24;
+}
+
+UIScrollBars::Layout UIListBox::layout_() const {
+    const int b = resolvedStyle<UIListBoxStyle>().borderPx;
+    const SDL_Rect area{ bounds.x + b, bounds.y + b, std::max(0, bounds.w - 2*b), std::max(0, bounds.h - 2*b) };
+    return bars.layout(area, 0.0, (double)count_ * rowHeight());
+}
+
+int UIListBox::visibleRows_() const {
+    const int rh = std::max(1, rowHeight());
+    return std::max(1, layout_().view.h / rh);
+}
+
+void UIListBox::setScroll_(double y) {
+    if (bars.setOffset(layout_(), 1, y)) markDirty();
+}
+
+void UIListBox::scrollToItem(size_t index) {
+    if (index >= count_) return;
+    const double rh = rowHeight();
+    setScroll_(bars.reveal(layout_(), 1, index * rh, rh));
+}
+
+void UIListBox::select(size_t index, bool scrollIntoView) {
+    if (index != npos && index >= count_) return;
+    if (scrollIntoView && index != npos) scrollToItem(index);
+    if (index == selected_) return;
+    selected_ = index;
+    markDirty();
+    if (onSelectionChanged) onSelectionChanged(index);
+}
+
+void UIListBox::moveSelection_(long long delta) {
+    if (count_ == 0) return;
+    const long long from = selected_ == npos ? (delta > 0 ? -1 : (long long)count_) : (long long)selected_;
+    select((size_t)std::clamp(from + delta, 0LL, (long long)count_ - 1));
+}
+
+void UIListBox::choose_(size_t index) {
+    select(index);
+    if (onActivate && index != npos) onActivate(index);
+}
+
+void UIListBox::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        if (e.user.code == 0xF001) { focused = true;  return; }
+        if (e.user.code == 0xF002) { focused = false; bars.cancelDrag(); return; }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; hoverIdx = npos; return; }
+    }
+    if (!enabled) return;
+    if (e.type == SDL_MOUSEWHEEL && !hovered) return;
+
+    const UIScrollBars::Layout l = layout_();
+    if (bars.handleMouse(e, l, (double)WHEEL_ROWS * rowHeight(), [this](int, double y) { setScroll_(y); })) return;
+
+    if (e.type == SDL_MOUSEMOTION) {
+        hoverIdx = bars.rowAt(l, e.motion.x, e.motion.y, rowHeight(), count_);
+        return;
+    }
+
+    if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+        const SDL_Point p{ e.button.x, e.button.y };
+        if (!SDL_PointInRect(&p, &bounds)) return;
+        const size_t i = bars.rowAt(l, p.x, p.y, rowHeight(), count_);
+        if (i == npos) return;
+        if (e.button.clicks >= 2) choose_(i);
+        else select(i);
+        return;
+    }
+
+    if (!focused || e.type != SDL_KEYDOWN) return;
+    const long long page = std::max(1, visibleRows_() - 1);
+    switch (e.key.keysym.sym) {
+        case SDLK_UP:       moveSelection_(-1); break;
+        case SDLK_DOWN:     moveSelection_(1); break;
+        case SDLK_PAGEUP:   moveSelection_(-page); break;
+        case SDLK_PAGEDOWN: moveSelection_(page); break;
+        case SDLK_HOME:     if (count_) select(0); break;
+        case SDLK_END:      if (count_) select(count_ - 1); break;
+        case SDLK_RETURN:
+        case SDLK_KP_ENTER: if (selected_ != npos) choose_(selected_); break;
+        default: break;
+    }
+}
+
+void UIListBox::update(float) {
+    const size_t n = countFn ? countFn() : 0;
+    if (n != count_) invalidateItems();
+}
+
+void UIListBox::render(SDL_Renderer* renderer) {
+    if (!visible) return;
+    const auto st = resolvedStyle<UIListBoxStyle>();
+    TTF_Font* f = activeFont_();
+
+    const LookStamp look = lookStamp();
+    if (look != seenLook) { seenLook = look; rows.invalidateAll(); }
+
+    SDL_Color borderNow = focused ? st.borderFocus : (hovered ? st.borderHover : st.border);
+    if (st.borderPx > 0) {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, borderNow);
+        UIHelpers::FillRoundedRect(renderer, bounds.x + st.borderPx, bounds.y + st.borderPx,
+                                   bounds.w - 2*st.borderPx, bounds.h - 2*st.borderPx,
+                                   std::max(0, st.radius - st.borderPx), st.bg);
+    } else {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.bg);
+    }
+    if (count_ == 0) return;
+
+    const UIScrollBars::Layout l = layout_();
+    const SDL_Rect in = l.view;
+    const int rh = std::max(1, rowHeight());
+    rows.setCapacity((size_t)(in.h / rh) + 2);
+
+    SDL_Rect prevClip;
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer);
+    SDL_RenderGetClipRect(renderer, &prevClip);
+    SDL_Rect clip = in;
+    if (hadClip) SDL_IntersectRect(&prevClip, &in, &clip);
+    SDL_RenderSetClipRect(renderer, &clip);
+
+    const double scrollY = bars.offset(1);
+    const size_t first = (size_t)(scrollY / rh);
+    const int y0 = in.y - (int)(scrollY - (double)first * rh);
+    const int textMaxW = std::max(0, in.w - 2*st.padX);
+    for (size_t i = first; i < count_; ++i) {
+        const int y = y0 + (int)(i - first) * rh;
+        if (y >= in.y + in.h) break;
+        const SDL_Rect row{ in.x + 4, y, in.w - 8, rh };
+        const bool isSel = (i == selected_);
+        if (isSel || i == hoverIdx)
+            UIHelpers::FillRoundedRect(renderer, row.x, row.y + 2, row.w, row.h - 4, 6, isSel ? st.selectedBg : st.hoverBg);
+        if (!f) continue;
+        SDL_Color fg = isSel ? st.selectedFg : st.fg;
+        if (!enabled) fg.a = 160;
+        const UITextRowCache::Row t = rows.get(renderer, f, fg, i, textMaxW, [&] { return itemFn(i); });
+        if (!t.texture) continue;
+        const SDL_Rect src{ 0, 0, t.w, t.h };
+        const SDL_Rect dst{ in.x + st.padX, y + (rh - t.h) / 2, t.w, t.h };
+        SDL_RenderCopy(renderer, t.texture, &src, &dst);
+    }
+
+    SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
+    bars.render(renderer, l, st.scrollTrack, st.scrollThumb);
+}
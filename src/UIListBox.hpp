@@ -0,0 +1,75 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UIScrollBars.hpp"
+#include "UITextRowCache.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Single-selection list over a data provider. Items are only asked for when
+// their row is on screen, and row textures come from a pool sized to the
+// viewport, so a frame costs the same for ten items as for ten million.
+// The provider must answer count() and item(i) cheaply; call
+// invalidateItems() after the underlying data changes.
+class UIListBox : public UIElement {
+public:
+    static constexpr size_t npos = (size_t)-1;
+    using CountFn = std::function<size_t()>;
+    using ItemFn  = std::function<std::string(size_t)>;
+
+    UIListBox(int x, int y, int w, int h);
+
+    UIListBox* setModel(CountFn count, ItemFn item);
+    // Convenience for small, static lists; the vector is copied.
+    UIListBox* setItems(std::vector<std::string> items);
+    void invalidateItems();
+    void invalidateItem(size_t index);
+    size_t itemCount() const { return count_; }
+
+    UIListBox* setFont(TTF_Font* f);
+    // 0 picks the font height plus padding.
+    UIListBox* setRowHeight(int px);
+    int rowHeight() const;
+
+    size_t selected() const { return selected_; }
+    void select(size_t index, bool scrollIntoView = true);
+    void scrollToItem(size_t index);
+    UIListBox* setOnSelectionChanged(std::function<void(size_t)> cb) { onSelectionChanged = std::move(cb); return this; }
+    // Enter or double-click on an item.
+    UIListBox* setOnActivate(std::function<void(size_t)> cb) { onActivate = std::move(cb); return this; }
+
+    void handleEvent(const SDL_Event& e) override;
+    void update(float dt) override;
+    void render(SDL_Renderer* renderer) override;
+    bool isHovered() const override { return hovered; }
+    bool isFocusable() const override { return true; }
+
+private:
+    CountFn countFn;
+    ItemFn  itemFn;
+    std::vector<std::string> ownedItems;
+    size_t count_ = 0;
+
+    TTF_Font* font = nullptr;
+    int rowH = 0;
+
+    size_t selected_ = npos;
+    size_t hoverIdx = npos;
+    UIScrollBars bars{ false, true };   // offsets in pixels; double keeps large models exact
+    bool focused = false;
+    bool hovered = false;
+
+    std::function<void(size_t)> onSelectionChanged;
+    std::function<void(size_t)> onActivate;
+
+    UITextRowCache rows;
+    LookStamp seenLook;
+
+    TTF_Font* activeFont_() const;
+    UIScrollBars::Layout layout_() const;
+    int visibleRows_() const;
+    void setScroll_(double y);
+    void moveSelection_(long long delta);
+    void choose_(size_t index);
+};
@@ -0,0 +1,240 @@
+#include "UILogView.hpp"
+#include "UIWorker.hpp"
+#include <algorithm>
+
+static constexpr int WHEEL_LINES   = 3;
+static constexpr int KEY_X_PX      = 48;
+static constexpr int PAD_PX        = 6;
+static constexpr int MAX_LINE_PX   = 4096;   // longer lines are cut off
+
+UILogView::UILogView(int x, int y, int w, int h, size_t maxLines)
+    : ring(std::max<size_t>(1, maxLines)) {
+    bounds = { x, y, w, h };
+}
+
+void UILogView::append(std::string_view t) { enqueue_(t, SDL_Color{ 0, 0, 0, 0 }, false); }
+void UILogView::append(std::string_view t, SDL_Color color) { enqueue_(t, color, true); }
+
+void UILogView::enqueue_(std::string_view t, SDL_Color color, bool hasColor) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        wake = pending.empty();
+        for (;;) {
+            const size_t nl = t.find('\n');
+            std::string_view part = t.substr(0, nl);
+            if (!part.empty() && part.back() == '\r') part.remove_suffix(1);
+            Line l;
+            l.text.assign(part.data(), part.size());
+            l.color = color;
+            l.hasColor = hasColor;
+            pending.push_back(std::move(l));
+            if (nl == std::string_view::npos) break;
+            t.remove_prefix(nl + 1);
+        }
+        // A producer far ahead of the UI: anything beyond one ring's worth
+        // would be evicted on arrival anyway.
+        const size_t cap = ring.size();
+        if (pending.size() >= 2 * cap) pending.erase(pending.begin(), pending.end() - cap);
+    }
+    if (wake) UIWorker::wakeUI();
+}
+
+void UILogView::clear() {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pending.clear();
+    clearPending = true;
+}
+
+void UILogView::push_(Line&& l) {
+    if (count < ring.size()) {
+        ring[(start + count) % ring.size()] = std::move(l);
+        ++count;
+    } else {
+        ring[start] = std::move(l);
+        start = (start + 1) % ring.size();
+        ++firstSeq;
+    }
+}
+
+UILogView* UILogView::setMaxLines(size_t n) {
+    n = std::max<size_t>(1, n);
+    if (n == ring.size()) return this;
+    std::vector<Line> next(n);
+    const size_t keep = std::min(count, n);
+    for (size_t i = 0; i < keep; ++i) next[i] = std::move(line_(count - keep + i));
+    firstSeq += count - keep;
+    {
+        // enqueue_ reads the capacity on producer threads.
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        ring.swap(next);
+    }
+    start = 0;
+    count = keep;
+    setScroll_(1, follow ? maxScroll_(1) : bars.offset(1));
+    markDirty();
+    return this;
+}
+
+UILogView* UILogView::setFollowTail(bool on) {
+    follow = on;
+    if (on) setScroll_(1, maxScroll_(1));
+    return this;
+}
+
+UILogView* UILogView::setFont(TTF_Font* f) {
+    font = f;
+    for (size_t i = 0; i < count; ++i) line_(i).width = -1;
+    maxWidth = 0;
+    text.invalidateAll();
+    markDirty();
+    return this;
+}
+
+// One lock per frame regardless of how many lines arrived.
+void UILogView::update(float) {
+    bool reset;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        drained.swap(pending);
+        reset = clearPending;
+        clearPending = false;
+    }
+    if (reset) {
+        for (size_t i = 0; i < count; ++i) line_(i) = Line{};
+        start = count = 0;
+        firstSeq = 0;
+        maxWidth = 0;
+        bars.reset();
+        follow = true;
+        text.invalidateAll();
+        markDirty();
+    }
+    if (drained.empty()) return;
+
+    const Uint64 before = firstSeq;
+    for (Line& l : drained) push_(std::move(l));
+    drained.clear();
+    const Uint64 evicted = firstSeq - before;
+
+    if (follow) {
+        setScroll_(1, maxScroll_(1));
+    } else {
+        // Keep the same lines under the viewport while old ones drop off.
+        setScroll_(1, bars.offset(1) - (double)evicted * lineHeight_());
+    }
+    markDirty();
+}
+
+TTF_Font* UILogView::activeFont_() const {
+    if (font) return font;
+    const UITheme& th = getTheme();
+    return th.font ? th.font : UIConfig::getDefaultFont();
+}
+
+int UILogView::lineHeight_() const {
+    TTF_Font* f = activeFont_();
+    return f ? std::max(1, TTF_FontHeight(f)) : 16;
+}
+
+UIScrollBars::Layout UILogView::layout_() const {
+    const int b = resolvedStyle<UITextAreaStyle>().borderPx + PAD_PX;
+    const SDL_Rect area{ bounds.x + b, bounds.y + b, std::max(0, bounds.w - 2*b), std::max(0, bounds.h - 2*b) };
+    return bars.layout(area, (double)maxWidth, (double)count * lineHeight_());
+}
+
+void UILogView::setScroll_(int axis, double v) {
+    const UIScrollBars::Layout l = layout_();
+    if (axis == 1) follow = v >= bars.maxOffset(l, 1);
+    if (bars.setOffset(l, axis, v)) markDirty();
+}
+
+void UILogView::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        if (e.user.code == 0xF001) { focused = true;  return; }
+        if (e.user.code == 0xF002) { focused = false; bars.cancelDrag(); return; }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
+    }
+    if (!enabled) return;
+    if (e.type == SDL_MOUSEWHEEL && !hovered) return;
+
+    const UIScrollBars::Layout l = layout_();
+    if (bars.handleMouse(e, l, (double)WHEEL_LINES * lineHeight_(),
+                         [this](int axis, double v) { setScroll_(axis, v); })) return;
+
+    if (!focused || e.type != SDL_KEYDOWN) return;
+    const double lh = lineHeight_(), page = std::max(lh, l.view.h - lh);
+    const double y = bars.offset(1), x = bars.offset(0);
+    switch (e.key.keysym.sym) {
+        case SDLK_UP:       setScroll_(1, y - lh); break;
+        case SDLK_DOWN:     setScroll_(1, y + lh); break;
+        case SDLK_PAGEUP:   setScroll_(1, y - page); break;
+        case SDLK_PAGEDOWN: setScroll_(1, y + page); break;
+        case SDLK_HOME:     setScroll_(1, 0.0); break;
+        case SDLK_END:      setFollowTail(true); break;
+        case SDLK_LEFT:     setScroll_(0, x - KEY_X_PX); break;
+        case SDLK_RIGHT:    setScroll_(0, x + KEY_X_PX); break;
+        default: break;
+    }
+}
+
+void UILogView::render(SDL_Renderer* renderer) {
+    if (!visible) return;
+    const auto st = resolvedStyle<UITextAreaStyle>();
+    const UITheme& th = getTheme();
+    TTF_Font* f = activeFont_();
+
+    const LookStamp look = lookStamp();
+    if (look != seenLook) { seenLook = look; text.invalidateAll(); }
+
+    SDL_Color borderNow = focused ? st.borderFocus : (hovered ? st.borderHover : st.border);
+    if (st.borderPx > 0) {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, borderNow);
+        UIHelpers::FillRoundedRect(renderer, bounds.x + st.borderPx, bounds.y + st.borderPx,
+                                   bounds.w - 2*st.borderPx, bounds.h - 2*st.borderPx,
+                                   std::max(0, st.radius - st.borderPx), st.bg);
+    } else {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.bg);
+    }
+    if (count == 0 || !f) return;
+
+    const UIScrollBars::Layout l = layout_();
+    const SDL_Rect v = l.view;
+    const int lh = lineHeight_();
+    text.setCapacity((size_t)(v.h / lh) + 2);
+
+    SDL_Rect prevClip;
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer);
+    SDL_RenderGetClipRect(renderer, &prevClip);
+    SDL_Rect clip = v;
+    if (hadClip) SDL_IntersectRect(&prevClip, &v, &clip);
+    SDL_RenderSetClipRect(renderer, &clip);
+
+    const size_t first = (size_t)(bars.offset(1) / lh);
+    const int y0 = v.y - (int)(bars.offset(1) - (double)first * lh);
+    const int sx = (int)bars.offset(0);
+    for (size_t i = first; i < count; ++i) {
+        const int y = y0 + (int)(i - first) * lh;
+        if (y >= v.y + v.h) break;
+        Line& l = line_(i);
+        if (l.width < 0) {
+            int w = 0, h = 0;
+            if (!l.text.empty()) TTF_SizeUTF8(f, l.text.c_str(), &w, &h);
+            l.width = std::min(w, MAX_LINE_PX);
+            if (l.width > maxWidth) maxWidth = l.width;
+        }
+        if (l.width == 0 || l.width <= sx) continue;
+        SDL_Color fg = l.hasColor ? l.color : st.fg;
+        if (!enabled) fg.a = 160;
+        const auto t = text.get(renderer, f, fg, (size_t)(firstSeq + i), MAX_LINE_PX, [&] { return l.text; });
+        if (!t.texture || t.w <= sx) continue;
+        const int w = std::min(t.w - sx, v.w);
+        const SDL_Rect src{ sx, 0, w, t.h };
+        const SDL_Rect dst{ v.x, y, w, t.h };
+        SDL_RenderCopy(renderer, t.texture, &src, &dst);
+    }
+
+    SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
+    bars.render(renderer, l, th.sliderTrackColor, th.sliderThumbColor);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UIScrollBars.hpp"
+#include "UITextRowCache.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only log console. Lines go into a fixed-size ring, so appending
+// costs the same whether it holds a hundred lines or a million, and the
+// oldest lines fall off the top. append() may be called from any thread:
+// lines are queued and moved into the ring in one batch per update().
+// Each line is measured once, when first drawn.
+class UILogView : public UIElement {
+public:
+    UILogView(int x, int y, int w, int h, size_t maxLines = 10000);
+
+    // Thread-safe. Text containing '\n' becomes several lines.
+    void append(std::string_view text);
+    void append(std::string_view text, SDL_Color color);
+    void clear();
+
+    UILogView* setMaxLines(size_t n);
+    size_t maxLines() const { return ring.size(); }
+    size_t lineCount() const { return count; }
+    // Lines that fell off the top since construction or clear().
+    Uint64 evictedLines() const { return firstSeq; }
+
+    // While following, new lines keep the view pinned to the bottom.
+    // Scrolling up stops following; scrolling back to the end resumes.
+    UILogView* setFollowTail(bool on);
+    bool isFollowingTail() const { return follow; }
+
+    UILogView* setFont(TTF_Font* f);
+
+    void handleEvent(const SDL_Event& e) override;
+    void update(float dt) override;
+    void render(SDL_Renderer* renderer) override;
+    bool isHovered() const override { return hovered; }
+    bool isFocusable() const override { return true; }
+
+private:
+    struct Line {
+        std::string text;
+        SDL_Color color{ 0, 0, 0, 0 };
+        bool hasColor = false;
+        int width = -1;              // measured on first draw
+    };
+
+    std::vector<Line> ring;
+    size_t start = 0, count = 0;
+    Uint64 firstSeq = 0;             // sequence number of ring[start]
+    int maxWidth = 0;
+
+    std::mutex pendingMutex;
+    std::vector<Line> pending;
+    std::vector<Line> drained;       // UI thread; swapped with pending
+    bool clearPending = false;
+
+    TTF_Font* font = nullptr;
+    UIScrollBars bars;
+    bool follow = true;
+    bool focused = false;
+    bool hovered = false;
+
+    UITextRowCache text;
+    LookStamp seenLook;
+
+    void enqueue_(std::string_view text, SDL_Color color, bool hasColor);
+    void push_(Line&& l);
+    Line& line_(size_t i) { return ring[(start + i) % ring.size()]; }
+
+    TTF_Font* activeFont_() const;
+    int lineHeight_() const;
+    UIScrollBars::Layout layout_() const;
+    double maxScroll_(int axis) const { return bars.maxOffset(layout_(), axis); }
+    void setScroll_(int axis, double v);
+};
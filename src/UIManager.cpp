@@ -1,10 +1,13 @@
 #include "UIManager.hpp"
+#include "UIWorker.hpp"
 #include <SDL2/SDL.h>
 #include <algorithm>
 
 namespace {
 constexpr int FOCUS_GAIN = 0xF001;
 constexpr int FOCUS_LOST = 0xF002;
+constexpr int HOVER_ENTER = 0xF003;
+constexpr int HOVER_LEAVE = 0xF004;
 
 inline bool isMouseEvent(const SDL_Event& e) {
     switch (e.type) {
@@ -19,42 +22,260 @@ inline bool isMouseEvent(const SDL_Event& e) {
 inline bool isKey(const SDL_Event& e, SDL_Keycode k) {
     return e.type == SDL_KEYDOWN && e.key.keysym.sym == k;
 }
-inline bool modsEqual(Uint16 desired) {
-    const Uint16 mask = (KMOD_CTRL | KMOD_ALT | KMOD_SHIFT | KMOD_GUI);
-    return (SDL_GetModState() & mask) == desired;
+// Key events a text editor ignores because SDL_TEXTINPUT carries the
+// character: releases, bare modifiers and unmodified printable keys.
+inline bool isTypingNoise(const SDL_Event& e) {
+    if (e.type == SDL_KEYUP) return true;
+    if (e.type != SDL_KEYDOWN) return false;
+    const SDL_Keycode k = e.key.keysym.sym;
+    if (k == SDLK_LCTRL || k == SDLK_RCTRL || k == SDLK_LSHIFT || k == SDLK_RSHIFT ||
+        k == SDLK_LALT  || k == SDLK_RALT  || k == SDLK_LGUI   || k == SDLK_RGUI) return true;
+    return !(e.key.keysym.mod & (KMOD_CTRL | KMOD_ALT | KMOD_GUI)) && k >= SDLK_SPACE && k < SDLK_DELETE;
+}
+// Left/right variants collapse to one bit each, lock keys are ignored.
+inline Uint16 normalizeMods(Uint16 m) {
+    Uint16 out = 0;
+    if (m & KMOD_CTRL)  out |= KMOD_CTRL;
+    if (m & KMOD_SHIFT) out |= KMOD_SHIFT;
+    if (m & KMOD_ALT)   out |= KMOD_ALT;
+    if (m & KMOD_GUI)   out |= KMOD_GUI;
+    return out;
 }
 }
 
-static void sendFocusEvent(UIElement* el, int code) {
+static void sendNotifyEvent(UIElement* el, int code) {
     if (!el) return;
     SDL_Event ev{};
     ev.type = SDL_USEREVENT;
     ev.user.code = code;
     ev.user.data1 = el;
     el->handleEvent(ev);
+    el->markDirty();
+}
+
+static UIElement* hitTestChildren(const std::vector<std::shared_ptr<UIElement>>& list, int x, int y) {
+    for (int i = (int)list.size() - 1; i >= 0; --i) {
+        const auto& el = list[i];
+        if (!el || !el->visible || !el->isInside(x, y)) continue;
+        if (auto group = dynamic_cast<UIGroupBox*>(el.get())) {
+            if (UIElement* child = hitTestChildren(group->getChildren(), x, y)) return child;
+        }
+        return el.get();
+    }
+    return nullptr;
 }
 
-UIManager::~UIManager() { cleanupCursors_(); }
+static constexpr int CULL_MARGIN = 8;
 
-void UIManager::addElement(std::shared_ptr<UIElement> el) {
-    elements.push_back(el);
-    if (el && el->isFocusable()) registerElement(el.get(), true);
+static bool outsideView(int x, int y, int w, int h, const SDL_Rect& view) {
+    return x + w + CULL_MARGIN <= view.x || y + h + CULL_MARGIN <= view.y ||
+           x - CULL_MARGIN >= view.x + view.w || y - CULL_MARGIN >= view.y + view.h;
+}
+
+UIManager::~UIManager() {
+    for (auto& el : elements) if (el) { el->attachTimers(nullptr); el->setObserver(nullptr); }
+    if (activePopup) activePopup->attachTimers(nullptr);
+    cleanupCursors_();
 }
-void UIManager::showPopup(std::shared_ptr<UIPopup> popup) {
-    if (activePopup) closePopup();
-    activePopup = std::move(popup);
 
-    savedFocusOrder_  = focusOrder_;
-    savedFocusedIndex_ = focusedIndex_;
+UIElementHandle UIManager::acquireHandle_(UIElement* el) {
+    if (!el) return {};
+    auto it = slotOf_.find(el);
+    if (it != slotOf_.end()) return { it->second, slots_[it->second].generation };
 
-    focusOrder_.clear();
-    if (activePopup) {
-        for (auto& ch : activePopup->children) {
-            if (ch && ch->isFocusable()) focusOrder_.push_back(ch.get());
+    Uint32 idx;
+    if (!freeSlots_.empty()) {
+        idx = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        idx = (Uint32)slots_.size();
+        slots_.emplace_back();
+    }
+    slots_[idx].element = el;
+    slotOf_.emplace(el, idx);
+    return { idx, slots_[idx].generation };
+}
+
+UIElement* UIManager::get(UIElementHandle h) const {
+    if (h.index >= slots_.size()) return nullptr;
+    const Slot& s = slots_[h.index];
+    return s.generation == h.generation ? s.element : nullptr;
+}
+
+UIElementHandle UIManager::handleOf(UIElement* el) const {
+    auto it = slotOf_.find(el);
+    if (it == slotOf_.end()) return {};
+    return { it->second, slots_[it->second].generation };
+}
+
+UIElementHandle UIManager::addElement(std::shared_ptr<UIElement> el) {
+    if (!el) return {};
+    UIElementHandle h = acquireHandle_(el.get());
+    Slot& slot = slots_[h.index];
+    if (slot.dense >= 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIManager::addElement: element already added");
+        return h;
+    }
+    el->attachTimers(&timers_);
+    el->setObserver(this);
+    slot.dense = (int)elements.size();
+    elementSlots_.push_back(h.index);
+
+    Uint8 kind = 0;
+    if (el->hasCustomHitTest()) kind |= META_CUSTOM_HIT;
+    if (dynamic_cast<UIGroupBox*>(el.get())) kind |= META_CONTAINER;
+    if (el->wantsFrameUpdate()) kind |= META_UPDATE;
+    const SDL_Rect& b = el->bounds;
+    meta_.x.push_back(b.x); meta_.y.push_back(b.y);
+    meta_.w.push_back(b.w); meta_.h.push_back(b.h);
+    meta_.kind.push_back(kind);
+    meta_.flags.push_back(kind | (el->visible ? META_VISIBLE : 0) | (el->enabled ? META_ENABLED : 0));
+    elements.push_back(std::move(el));
+    if (elements.back()->isFocusable()) registerElement(elements.back().get(), true);
+    hoverDirty_ = true;
+    return h;
+}
+
+bool UIManager::removeElement(UIElementHandle h) {
+    UIElement* el = get(h);
+    if (!el) return false;
+    const int dense = slots_[h.index].dense;
+    if (dense < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIManager::removeElement: not a top-level element");
+        return false;
+    }
+    graveyard_.push_back(std::move(elements[dense]));
+    meta_.flags[dense] = 0;
+    elementsDirty_ = true;
+    el->attachTimers(nullptr);
+    el->setObserver(nullptr);
+    releaseTree_(el);
+    return true;
+}
+
+bool UIManager::removeElement(UIElement* el) {
+    return removeElement(handleOf(el));
+}
+
+void UIManager::setUseArena(bool on, size_t slotsPerBlock) {
+    if (!on) { arena_.reset(); return; }
+    if (!arena_) arena_ = std::make_unique<UIWidgetArena>(slotsPerBlock);
+}
+
+// Invalidates every handle into el's subtree. The element loses focus, hover
+// and mouse capture; stale focus entries are dropped by the next compact_().
+void UIManager::releaseTree_(UIElement* el) {
+    if (!el) return;
+    if (auto group = dynamic_cast<UIGroupBox*>(el)) {
+        for (auto& ch : group->getChildren()) releaseTree_(ch.get());
+    } else if (auto popup = dynamic_cast<UIPopup*>(el)) {
+        for (auto& ch : popup->children) releaseTree_(ch.get());
+    }
+
+    auto it = slotOf_.find(el);
+    if (it == slotOf_.end()) return;
+    const Uint32 idx = it->second;
+    Slot& slot = slots_[idx];
+    const UIElementHandle h{ idx, slot.generation };
+
+    if (focusedElement_() == el) {
+        focusedIndex_ = -1;
+        sendNotifyEvent(el, FOCUS_LOST);
+    }
+    if (slot.focus >= 0) focusDirty_ = true;
+    if (mouseCaptured_ == h) SDL_CaptureMouse(SDL_FALSE);
+    if (hoveredElement_ == h) hoverDirty_ = true;
+
+    slot.element = nullptr;
+    slot.dense = -1;
+    slot.focus = -1;
+    if (++slot.generation == 0) slot.generation = 1;
+    freeSlots_.push_back(idx);
+    slotOf_.erase(it);
+}
+
+void UIManager::compact_() {
+    if (elementsDirty_) {
+        size_t w = 0;
+        for (size_t r = 0; r < elements.size(); ++r) {
+            if (!elements[r]) continue;
+            if (w != r) {
+                elements[w] = std::move(elements[r]);
+                elementSlots_[w] = elementSlots_[r];
+                meta_.x[w] = meta_.x[r]; meta_.y[w] = meta_.y[r];
+                meta_.w[w] = meta_.w[r]; meta_.h[w] = meta_.h[r];
+                meta_.flags[w] = meta_.flags[r];
+                meta_.kind[w] = meta_.kind[r];
+            }
+            slots_[elementSlots_[w]].dense = (int)w;
+            ++w;
         }
+        elements.resize(w);
+        elementSlots_.resize(w);
+        meta_.x.resize(w); meta_.y.resize(w);
+        meta_.w.resize(w); meta_.h.resize(w);
+        meta_.flags.resize(w);
+        meta_.kind.resize(w);
+        graveyard_.clear();
+        elementsDirty_ = false;
+    }
+    if (focusDirty_) compactFocus_();
+}
+
+void UIManager::syncMetaAt_(size_t i) {
+    const UIElement* el = elements[i].get();
+    if (!el) { meta_.flags[i] = 0; return; }
+    const SDL_Rect& b = el->bounds;
+    meta_.x[i] = b.x; meta_.y[i] = b.y;
+    meta_.w[i] = b.w; meta_.h[i] = b.h;
+    meta_.flags[i] = meta_.kind[i] | (el->visible ? META_VISIBLE : 0) | (el->enabled ? META_ENABLED : 0);
+}
+
+// setPosition/setSize/setBounds/setEnabled/setVisible on a top-level element.
+void UIManager::elementChanged(UIElement* el) {
+    auto it = slotOf_.find(el);
+    if (it == slotOf_.end()) return;
+    const int dense = slots_[it->second].dense;
+    if (dense >= 0 && elements[dense].get() == el) syncMetaAt_((size_t)dense);
+    hoverDirty_ = true;
+}
+
+// Topmost (last in z order) visible element containing the point, or -1.
+int UIManager::hitTestIndex_(int x, int y) const {
+    const int* X = meta_.x.data();
+    const int* Y = meta_.y.data();
+    const int* W = meta_.w.data();
+    const int* H = meta_.h.data();
+    const Uint8* F = meta_.flags.data();
+    for (int i = (int)meta_.flags.size() - 1; i >= 0; --i) {
+        const Uint8 f = F[i];
+        if (!(f & META_VISIBLE)) continue;
+        if (f & META_CUSTOM_HIT) {
+            if (elements[i]->isInside(x, y)) return i;
+            continue;
+        }
+        if (x >= X[i] && x <= X[i] + W[i] && y >= Y[i] && y <= Y[i] + H[i]) return i;
+    }
+    return -1;
+}
+void UIManager::showPopup(std::shared_ptr<UIPopup> popup) {
+    if (activePopup) {
+        finishPopupClose_();
+        pendingPopupClose = false;
+    }
+    setHovered_(nullptr);
+    pressTarget_ = {};
+    hoverDirty_ = true;
+    activePopup = std::move(popup);
+    backdropDirty_ = true;
+    if (!activePopup) return;
+    activePopup->attachTimers(&timers_);
+
+    pushFocusScope_();
+    for (auto& ch : activePopup->children) {
+        if (ch && ch->isFocusable()) registerElement(ch.get(), true);
     }
     if (!focusOrder_.empty()) setFocusedIndex_(0);
-    else clearFocus();
 }
 std::shared_ptr<UIPopup> UIManager::GetActivePopup() { return activePopup; }
 void UIManager::closePopup() { pendingPopupClose = true; }
@@ -81,163 +302,344 @@ void UIManager::cleanupCursors_() {
     cursorsReady = false;
 }
 
-void UIManager::checkCursorForElement(const std::shared_ptr<UIElement>& el, SDL_Cursor*& cursorToUse) {
-    if (!el->visible) return;
+SDL_Cursor* UIManager::cursorForHovered_() {
+    UIElement* el = get(hoveredElement_);
+    if (!el) return arrowCursor;
 
-    if (auto ta = dynamic_cast<UITextArea*>(el.get())) {
-        if (ta->isScrollbarHovered() || ta->isScrollbarDragging()) return;
-        if (ta->isHovered()) { cursorToUse = ibeamCursor; return; }
+    if (auto ta = dynamic_cast<UITextArea*>(el)) {
+        if (ta->isScrollbarHovered() || ta->isScrollbarDragging()) return arrowCursor;
+        return ibeamCursor;
     }
-    
-    if (el->isHovered() && dynamic_cast<UITextField*>(el.get())) { 
-        cursorToUse = ibeamCursor; 
-        return; 
+    if (dynamic_cast<UITextField*>(el)) return ibeamCursor;
+
+    if (auto combo = dynamic_cast<UIComboBox*>(el)) {
+        if (combo->isHovered() || combo->isHoveringDropdown(pointer_.x, pointer_.y)) return handCursor;
+        return arrowCursor;
     }
-    
-    if (auto combo = dynamic_cast<UIComboBox*>(el.get())) {
-        if (combo->isHovered() && cursorToUse != ibeamCursor) {
-            cursorToUse = handCursor;
-        }
-        
-        if (combo->isExpanded()) {
-            int mx, my; 
-            SDL_GetMouseState(&mx, &my);
-            if (combo->isHoveringDropdown(mx, my) && cursorToUse != ibeamCursor) {
-                cursorToUse = handCursor;
-                return;
-            }
-        }
-        return;
+
+    if (el->isHovered() &&
+        (dynamic_cast<UIButton*>(el)   ||
+         dynamic_cast<UICheckbox*>(el) ||
+         dynamic_cast<UISlider*>(el)   ||
+         dynamic_cast<UISpinner*>(el))) {
+        return handCursor;
     }
-    
-    if (el->isHovered() && cursorToUse != ibeamCursor) {
-        if (dynamic_cast<UIButton*>(el.get())   ||
-            dynamic_cast<UICheckbox*>(el.get()) ||
-            dynamic_cast<UISlider*>(el.get())   ||
-            dynamic_cast<UISpinner*>(el.get())) {
-            cursorToUse = handCursor;
-        }
+    return arrowCursor;
+}
+
+void UIManager::trackPointer_(const SDL_Event& e) {
+    switch (e.type) {
+        case SDL_MOUSEMOTION:
+            pointer_.x = e.motion.x; pointer_.y = e.motion.y;
+            pointer_.buttons = e.motion.state;
+            pointer_.valid = true;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+            pointer_.x = e.button.x; pointer_.y = e.button.y;
+            pointer_.buttons |= SDL_BUTTON(e.button.button);
+            pointer_.valid = true;
+            break;
+        case SDL_MOUSEBUTTONUP:
+            pointer_.x = e.button.x; pointer_.y = e.button.y;
+            pointer_.buttons &= ~SDL_BUTTON(e.button.button);
+            if (pointer_.buttons == 0) pressTarget_ = {};
+            break;
+        case SDL_MOUSEWHEEL:
+            break;
+        case SDL_WINDOWEVENT:
+            if (e.window.event != SDL_WINDOWEVENT_LEAVE) return;
+            pointer_.valid = false;
+            break;
+        default:
+            return;
     }
-    
-    if (auto group = dynamic_cast<UIGroupBox*>(el.get())) {
-        for (auto& child : group->getChildren()) {
-            checkCursorForElement(child, cursorToUse);
-            if (cursorToUse == ibeamCursor) return;
-        }
+    hoverDirty_ = true;
+}
+
+UIElement* UIManager::hitTestHover_(int x, int y) {
+    if (activePopup && activePopup->visible) return hitTestChildren(activePopup->children, x, y);
+    UIElement* combo = get(activeComboBox_);
+    if (combo && combo->isInside(x, y)) return combo;
+    const int idx = hitTestIndex_(x, y);
+    if (idx < 0) return nullptr;
+    UIElement* el = elements[idx].get();
+    if (meta_.flags[idx] & META_CONTAINER) {
+        if (UIElement* child = hitTestChildren(static_cast<UIGroupBox*>(el)->getChildren(), x, y)) return child;
+    }
+    return el;
+}
+
+void UIManager::setHovered_(UIElement* el) {
+    UIElement* prev = get(hoveredElement_);
+    if (el == prev) return;
+    hoveredElement_ = acquireHandle_(el);
+    sendNotifyEvent(prev, HOVER_LEAVE);
+    sendNotifyEvent(el, HOVER_ENTER);
+}
+
+void UIManager::refreshHover_() {
+    hoverDirty_ = false;
+    setHovered_(pointer_.valid ? hitTestHover_(pointer_.x, pointer_.y) : nullptr);
+}
+
+void UIManager::finishPopupClose_() {
+    setHovered_(nullptr);
+    hoverDirty_ = true;
+    popFocusScope_();
+    if (activePopup) {
+        activePopup->attachTimers(nullptr);
+        releaseTree_(activePopup.get());
+    }
+    activePopup.reset();
+    releaseBackdrop_();
+}
+
+// The focused element of the covered layer gets FOCUS_LOST, and FOCUS_GAIN
+// again when its layer is restored. Vectors are swapped, never copied.
+void UIManager::pushFocusScope_() {
+    FocusScope scope;
+    scope.focused = focusedIndex_;
+    clearFocus();
+    scope.order.swap(focusOrder_);
+    focusStack_.push_back(std::move(scope));
+}
+
+// Each element belongs to one layer, so Slot::focus stays valid while its
+// layer is stacked; only entries removed in the meantime need compacting.
+void UIManager::popFocusScope_() {
+    if (focusStack_.empty()) return;
+    clearFocus();
+    FocusScope& scope = focusStack_.back();
+    focusOrder_.swap(scope.order);
+    const int restore = scope.focused;
+    const UIElementHandle restoreHandle =
+        (restore >= 0 && restore < (int)focusOrder_.size()) ? focusOrder_[restore] : UIElementHandle{};
+    focusStack_.pop_back();
+    compactFocus_();
+    if (get(restoreHandle)) setFocusedIndex_(slots_[restoreHandle.index].focus);
+}
+
+void UIManager::compactFocus_() {
+    const UIElementHandle focused =
+        (focusedIndex_ >= 0 && focusedIndex_ < (int)focusOrder_.size()) ? focusOrder_[focusedIndex_] : UIElementHandle{};
+    size_t w = 0;
+    for (size_t r = 0; r < focusOrder_.size(); ++r) {
+        const UIElementHandle h = focusOrder_[r];
+        if (!get(h)) continue;
+        slots_[h.index].focus = (int)w;
+        focusOrder_[w++] = h;
     }
+    focusOrder_.resize(w);
+    focusedIndex_ = get(focused) ? slots_[focused.index].focus : -1;
+    focusDirty_ = false;
 }
 
 void UIManager::registerElement(UIElement* e, bool focusable) {
-    if (e && focusable) focusOrder_.push_back(e);
+    if (!e || !focusable) return;
+    const UIElementHandle h = acquireHandle_(e);
+    Slot& slot = slots_[h.index];
+    if (slot.focus >= 0) return;
+    slot.focus = (int)focusOrder_.size();
+    focusOrder_.push_back(h);
 }
 void UIManager::setFocusOrder(const std::vector<UIElement*>& order) {
-    focusOrder_ = order;
+    for (const auto& h : focusOrder_)
+        if (get(h)) slots_[h.index].focus = -1;
+    focusOrder_.clear();
+    for (UIElement* e : order) registerElement(e, true);
     if (focusedIndex_ >= (int)focusOrder_.size()) focusedIndex_ = -1;
 }
 void UIManager::focusNext() {
-    if (focusOrder_.empty()) return;
-    int n = (int)focusOrder_.size();
-    int next = ((focusedIndex_ < 0 ? -1 : focusedIndex_) + 1) % n;
-    setFocusedIndex_(next);
+    const int n = (int)focusOrder_.size();
+    int next = focusedIndex_ < 0 ? -1 : focusedIndex_;
+    for (int k = 0; k < n; ++k) {
+        next = (next + 1) % n;
+        if (get(focusOrder_[next])) { setFocusedIndex_(next); return; }
+    }
 }
 void UIManager::focusPrev() {
-    if (focusOrder_.empty()) return;
-    int n = (int)focusOrder_.size();
-    int prev = ((focusedIndex_ < 0 ? 0 : focusedIndex_) - 1 + n) % n;
-    setFocusedIndex_(prev);
+    const int n = (int)focusOrder_.size();
+    int prev = focusedIndex_ < 0 ? 0 : focusedIndex_;
+    for (int k = 0; k < n; ++k) {
+        prev = (prev - 1 + n) % n;
+        if (get(focusOrder_[prev])) { setFocusedIndex_(prev); return; }
+    }
 }
 void UIManager::clearFocus() { setFocusedIndex_(-1); }
 
+// The focused element gets first go at Tab, so focus walks through a
+// container's children before leaving it.
+void UIManager::tabFocus_(bool backward) {
+    UIElement* f = focusedElement_();
+    if (f && f->stepFocus(!backward, false)) { f->markDirty(); return; }
+    if (backward) focusPrev(); else focusNext();
+    if (UIElement* n = focusedElement_()) {
+        if (n->stepFocus(!backward, true)) n->markDirty();
+    }
+}
+
 void UIManager::captureMouse(UIElement* e) {
-    mouseCaptured_ = e;
+    mouseCaptured_ = acquireHandle_(e);
     SDL_CaptureMouse(SDL_TRUE);
 }
 void UIManager::releaseMouse() {
-    mouseCaptured_ = nullptr;
+    mouseCaptured_ = {};
     SDL_CaptureMouse(SDL_FALSE);
 }
-void UIManager::setActiveModal(UIElement* m) { activeModal_ = m; }
-UIElement* UIManager::activeModal() const { return activeModal_; }
+void UIManager::setActiveModal(UIElement* m) { activeModal_ = acquireHandle_(m); }
+UIElement* UIManager::activeModal() const { return get(activeModal_); }
+void UIManager::setActiveComboBox(UIElement* combo) { activeComboBox_ = acquireHandle_(combo); }
+Uint64 UIManager::shortcutKey_(SDL_Keycode key, Uint16 mods, int scope) {
+    return ((Uint64)(Uint32)key << 32) | ((Uint64)normalizeMods(mods) << 8) | (Uint64)(scope & 0xFF);
+}
+
 void UIManager::registerShortcut(SDL_Keycode key, Uint16 mods, ShortcutScope scope, std::function<void()> cb) {
-    shortcuts_.push_back({key, mods, (int)scope, std::move(cb)});
+    if (!cb) return;
+    if (!shortcuts_.emplace(shortcutKey_(key, mods, scope), std::move(cb)).second) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "Shortcut %s (mods 0x%x) already registered for this scope", SDL_GetKeyName(key), mods);
+    }
 }
 
 bool UIManager::tryShortcuts_(const SDL_Event& e) {
-    if (e.type != SDL_KEYDOWN) return false;
-    const auto sym = e.key.keysym.sym;
-    for (auto& s : shortcuts_) {
-        if (s.key == sym && modsEqual(s.mods)) {
-            if (s.scope == ModalOnly && !activeModal_) continue;
-            if (s.cb) s.cb();
-            return true;
-        }
+    if (e.type != SDL_KEYDOWN || shortcuts_.empty()) return false;
+    const SDL_Keycode sym = e.key.keysym.sym;
+    const Uint16 mods = e.key.keysym.mod;
+    auto fire = [&](int scope) {
+        auto it = shortcuts_.find(shortcutKey_(sym, mods, scope));
+        if (it == shortcuts_.end()) return false;
+        it->second();
+        return true;
+    };
+    if (get(activeModal_) && fire(ModalOnly)) return true;
+    return fire(Global) || fire(WhenNoTextEditing);
+}
+
+// Delivers an input event and flags the receiver as damaged, except for
+// pointer motion that neither starts nor ends over it with no button held.
+void UIManager::dispatch_(UIElement* el, const SDL_Event& e) {
+    el->handleEvent(e);
+    if (e.type != SDL_MOUSEMOTION || pointer_.buttons ||
+        el->isInside(pointer_.x, pointer_.y) || el->isInside(prevPointer_.x, prevPointer_.y))
+        el->markDirty();
+}
+
+// Collects typing and held Backspace/Delete for a focused editor that
+// accepts bursts; returns true if the event was taken. Key-ups and the plain
+// key-downs that come with typed text continue down the normal path with the
+// burst still pending; anything else applies the burst first so the event
+// sees the text it follows.
+bool UIManager::bufferBurst_(const SDL_Event& e) {
+    UIElementHandle fh;
+    if (!activePopup && !get(activeComboBox_) && !get(activeModal_) &&
+        focusedIndex_ >= 0 && focusedIndex_ < (int)focusOrder_.size())
+        fh = focusOrder_[focusedIndex_];
+    UIElement* f = get(fh);
+    if (!f || !f->acceptsInputBursts()) { flushBurst_(); return false; }
+
+    if (e.type == SDL_TEXTINPUT) {
+        if (burstRepeats_ > 0 || burstTarget_ != fh) flushBurst_();
+        burstTarget_ = fh;
+        burstText_ += e.text.text;
+        return true;
+    }
+    if (e.type == SDL_KEYDOWN && e.key.repeat &&
+        (isKey(e, SDLK_BACKSPACE) || isKey(e, SDLK_DELETE)) &&
+        !(e.key.keysym.mod & (KMOD_CTRL | KMOD_ALT | KMOD_GUI))) {
+        if (!burstText_.empty() || burstTarget_ != fh || (burstRepeats_ > 0 &&
+            (burstKey_.keysym.sym != e.key.keysym.sym || burstKey_.keysym.mod != e.key.keysym.mod)))
+            flushBurst_();
+        burstTarget_ = fh;
+        burstKey_ = e.key;
+        ++burstRepeats_;
+        return true;
     }
+    if (burstTarget_ == fh && isTypingNoise(e)) return false;
+    flushBurst_();
     return false;
 }
 
-UIElement* UIManager::hitTestTopMost_(int x, int y) {
-    for (int i = (int)elements.size() - 1; i >= 0; --i) {
-        const auto& el = elements[i];
-        if (!el || !el->visible) continue;
-        if (el->isInside(x, y)) return el.get();
+void UIManager::flushBurst_() {
+    if (burstText_.empty() && burstRepeats_ == 0) return;
+    if (UIElement* el = get(burstTarget_)) {
+        if (!burstText_.empty()) el->handleTextBurst(burstText_);
+        else el->handleKeyRepeat(burstKey_, burstRepeats_);
+        el->markDirty();
     }
-    return nullptr;
+    burstTarget_ = {};
+    burstText_.clear();
+    burstRepeats_ = 0;
 }
 
 void UIManager::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT && e.user.code == UIWorker::WAKE_EVENT) return;
+    if (bufferBurst_(e)) return;
     if (e.type == SDL_MOUSEMOTION) ensureCursorsInit_();
+    if (e.type == SDL_RENDER_TARGETS_RESET) {
+        UILayerCache::invalidateAll();
+        backdropDirty_ = true;
+    }
+    UIElement* pressTarget = get(pressTarget_);
+    prevPointer_ = pointer_;
+    trackPointer_(e);
     if (activePopup) {
         if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_TAB) {
-            const bool shift = (SDL_GetModState() & KMOD_SHIFT) != 0;
-            if (shift) focusPrev(); else focusNext();
+            tabFocus_((SDL_GetModState() & KMOD_SHIFT) != 0);
             return;
         }
-        activePopup->handleEvent(e);
+        dispatch_(activePopup.get(), e);
         return;
     }
 
-    if (activeComboBox_) {
-        activeComboBox_->handleEvent(e);
+    if (UIElement* active = get(activeComboBox_)) {
+        dispatch_(active, e);
         
-        auto* combo = dynamic_cast<UIComboBox*>(activeComboBox_);
+        auto* combo = dynamic_cast<UIComboBox*>(active);
         if (combo && !combo->isExpanded()) {
-            activeComboBox_ = nullptr;
+            activeComboBox_ = {};
         }
         return;
     }
 
-    if (activeModal_) { activeModal_->handleEvent(e); return; }
+    UIElement* modal = get(activeModal_);
+    if (modal) { dispatch_(modal, e); return; }
 
-    if (isMouseEvent(e) && mouseCaptured_) { mouseCaptured_->handleEvent(e); return; }
+    if (isMouseEvent(e)) {
+        if (UIElement* captured = get(mouseCaptured_)) { dispatch_(captured, e); return; }
+    }
 
     if (e.type == SDL_KEYDOWN) {
         const bool shift = (SDL_GetModState() & KMOD_SHIFT) != 0;
-        if (isKey(e, SDLK_TAB)) { if (shift) focusPrev(); else focusNext(); return; }
+        if (isKey(e, SDLK_TAB)) { tabFocus_(shift); return; }
         if (isKey(e, SDLK_ESCAPE)) {
-            if (activePopup) { activePopup->handleEvent(e); return; }
-            if (activeModal_) { activeModal_->handleEvent(e); return; }
-            if (focusedIndex_ >= 0 && focusedIndex_ < (int)focusOrder_.size()) { focusOrder_[focusedIndex_]->handleEvent(e); return; }
+            if (activePopup) { dispatch_(activePopup.get(), e); return; }
+            if (modal) { dispatch_(modal, e); return; }
+            if (UIElement* f = focusedElement_()) { dispatch_(f, e); return; }
             clearFocus(); return;
         }
     }
 
     if (e.type == SDL_TEXTINPUT || e.type == SDL_TEXTEDITING || e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) {
-        if (focusedIndex_ >= 0 && focusedIndex_ < (int)focusOrder_.size()) { focusOrder_[focusedIndex_]->handleEvent(e); return; }
+        if (UIElement* f = focusedElement_()) { dispatch_(f, e); return; }
         if (tryShortcuts_(e)) return;
     }
 
     if (isMouseEvent(e)) {
-        int mx = 0, my = 0;
-        if (e.type == SDL_MOUSEMOTION) { mx = e.motion.x; my = e.motion.y; }
-        else if (e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP) { mx = e.button.x; my = e.button.y; }
-        else if (e.type == SDL_MOUSEWHEEL) { SDL_GetMouseState(&mx, &my); }
+        if (pressTarget && (e.type == SDL_MOUSEMOTION || e.type == SDL_MOUSEBUTTONUP)) {
+            dispatch_(pressTarget, e);
+            return;
+        }
 
-        if (UIElement* hit = hitTestTopMost_(mx, my)) {
+        const int hitIdx = hitTestIndex_(pointer_.x, pointer_.y);
+        if (UIElement* hit = hitIdx < 0 ? nullptr : elements[hitIdx].get()) {
             if (e.type == SDL_MOUSEBUTTONDOWN) {
-                int idx = findFocusIndex_(hit);
-                setFocusedIndex_(idx);
+                // A click on a disabled element still reaches it but does
+                // not move focus there.
+                if (meta_.flags[hitIdx] & META_ENABLED) setFocusedIndex_(findFocusIndex_(hit));
+                else clearFocus();
+                pressTarget_ = acquireHandle_(hit);
             }
-            hit->handleEvent(e);
+            dispatch_(hit, e);
             return;
         }
         if (e.type == SDL_MOUSEBUTTONDOWN) {
@@ -248,91 +650,222 @@ void UIManager::handleEvent(const SDL_Event& e) {
 
 
 void UIManager::update(float dt) {
+    flushBurst_();
     ensureCursorsInit_();
+    timers_.advance(SDL_GetTicks());
+    compact_();
     if (pendingPopupClose) {
-        activePopup.reset();
-        setFocusOrder(savedFocusOrder_);
-        if (savedFocusedIndex_ >= 0) setFocusedIndex_(savedFocusedIndex_); else clearFocus();
-        savedFocusOrder_.clear();
-        savedFocusedIndex_ = -1;
+        finishPopupClose_();
         pendingPopupClose = false;
     }
     if (activePopup && !activePopup->visible) {
-        activePopup.reset();
-        setFocusOrder(savedFocusOrder_);
-        if (savedFocusedIndex_ >= 0) setFocusedIndex_(savedFocusedIndex_); else clearFocus();
-        savedFocusOrder_.clear();
-        savedFocusedIndex_ = -1;
+        finishPopupClose_();
     }
 
+    UIElement* hovered = get(hoveredElement_);
+    if (hoverDirty_ || (hovered && !hovered->visible)) refreshHover_();
+
     SDL_Cursor* cursorToUse = arrowCursor;
 
     if (activePopup && activePopup->visible) {
         activePopup->update(dt);
-        for (const auto& child : activePopup->children) {
-            checkCursorForElement(child, cursorToUse);
-        }
+        cursorToUse = cursorForHovered_();
     } else {
         for (const auto& el : elements) {
             auto* combo = dynamic_cast<UIComboBox*>(el.get());
             if (combo && combo->shouldNotifyExpanded()) {
-                activeComboBox_ = combo;
+                activeComboBox_ = acquireHandle_(combo);
+                hoverDirty_ = true;
                 break;
             }
         }
         
-        if (activeComboBox_) {
-            auto* combo = dynamic_cast<UIComboBox*>(activeComboBox_);
+        if (UIElement* active = get(activeComboBox_)) {
+            auto* combo = dynamic_cast<UIComboBox*>(active);
             if (combo && combo->isExpanded()) {
                 combo->update(dt);
                 
-                int mx, my;
-                SDL_GetMouseState(&mx, &my);
-                
-                if (combo->isHoveringDropdown(mx, my)) {
-                    cursorToUse = handCursor;
-                }
-                else if (combo->isHovered()) {
+                if (combo->isHoveringDropdown(pointer_.x, pointer_.y) || combo->isHovered()) {
                     cursorToUse = handCursor;
                 }
                 
                 if (SDL_GetCursor() != cursorToUse) SDL_SetCursor(cursorToUse);
                 return;
             } else {
-                activeComboBox_ = nullptr;
+                activeComboBox_ = {};
+                hoverDirty_ = true;
             }
         }
         
-        for (const auto& el : elements) {
+        const bool cull = cullUpdate_ && haveCullView_;
+        UIElement* keep[] = { focusedElement_(), get(hoveredElement_), get(mouseCaptured_), get(pressTarget_) };
+        cullStats_.updated = cullStats_.updateCulled = 0;
+        for (size_t i = 0; i < elements.size(); ++i) {
+            UIElement* el = elements[i].get();
+            if (!el || !(meta_.kind[i] & META_UPDATE)) continue;
+            if (cull && outsideView(meta_.x[i], meta_.y[i], meta_.w[i], meta_.h[i], cullView_) &&
+                std::find(std::begin(keep), std::end(keep), el) == std::end(keep)) {
+                ++cullStats_.updateCulled;
+                continue;
+            }
             el->update(dt);
-            checkCursorForElement(el, cursorToUse);
+            ++cullStats_.updated;
         }
+        cursorToUse = cursorForHovered_();
     }
     if (SDL_GetCursor() != cursorToUse) SDL_SetCursor(cursorToUse);
 }
 
-void UIManager::render(SDL_Renderer* renderer) {
+void UIManager::setCulling(bool renderCulling, bool updateCulling) {
+    cullRender_ = renderCulling;
+    cullUpdate_ = updateCulling;
+}
+
+void UIManager::renderScene_(SDL_Renderer* renderer) {
+    SDL_Rect view{ 0, 0, 0, 0 };
+    SDL_RenderGetViewport(renderer, &view);
+    view.x = view.y = 0;
+    if (SDL_RenderIsClipEnabled(renderer)) {
+        SDL_Rect clip;
+        SDL_RenderGetClipRect(renderer, &clip);
+        SDL_IntersectRect(&view, &clip, &view);
+    }
+    const bool cull = cullRender_ && view.w > 0 && view.h > 0;
+    cullView_ = view;
+    haveCullView_ = view.w > 0 && view.h > 0;
+    cullStats_.drawn = cullStats_.culled = 0;
+
     UIComboBox* expandedCombo = nullptr;
-    for (auto& el : elements) {
-        if (!el->visible) continue;
-        
-        auto* combo = dynamic_cast<UIComboBox*>(el.get());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (!(meta_.flags[i] & META_VISIBLE)) continue;
+        UIElement* el = elements[i].get();
+
+        auto* combo = dynamic_cast<UIComboBox*>(el);
         if (combo && combo->isExpanded()) {
             expandedCombo = combo;
             combo->renderField(renderer);
         } else {
+            if (cull && outsideView(meta_.x[i], meta_.y[i], meta_.w[i], meta_.h[i], view)) { ++cullStats_.culled; continue; }
             el->render(renderer);
         }
+        ++cullStats_.drawn;
     }
     if (expandedCombo) {
         expandedCombo->renderDropdown(renderer);
     }
-    if (activePopup && activePopup->visible) {
+}
+
+void UIManager::setPopupBackdrop(PopupBackdrop mode, int blurRadius) {
+    backdropMode_ = mode;
+    blurRadius_ = std::max(0, blurRadius);
+    releaseBackdrop_();
+}
+
+void UIManager::releaseBackdrop_() {
+    backdrop_.reset();
+    backdropW_ = backdropH_ = 0;
+    backdropDirty_ = true;
+}
+
+// Three box passes approximate a gaussian. Runs once per captured backdrop.
+static void boxBlurARGB(std::vector<Uint32>& px, int w, int h, int radius) {
+    if (radius <= 0 || w <= 0 || h <= 0) return;
+    std::vector<Uint32> tmp(px.size());
+    auto pass = [radius](const Uint32* src, Uint32* dst, int n, int stride) {
+        const int win = 2 * radius + 1;
+        Uint32 sum[4] = {0, 0, 0, 0};
+        auto at = [&](int i) { return src[std::clamp(i, 0, n - 1) * stride]; };
+        for (int i = -radius; i <= radius; ++i) {
+            const Uint32 c = at(i);
+            for (int k = 0; k < 4; ++k) sum[k] += (c >> (8 * k)) & 0xFF;
+        }
+        for (int i = 0; i < n; ++i) {
+            Uint32 out = 0;
+            for (int k = 0; k < 4; ++k) out |= (sum[k] / win) << (8 * k);
+            dst[i * stride] = out;
+            const Uint32 add = at(i + radius + 1), sub = at(i - radius);
+            for (int k = 0; k < 4; ++k) sum[k] += ((add >> (8 * k)) & 0xFF) - ((sub >> (8 * k)) & 0xFF);
+        }
+    };
+    for (int it = 0; it < 3; ++it) {
+        for (int y = 0; y < h; ++y) pass(&px[(size_t)y * w], &tmp[(size_t)y * w], w, 1);
+        for (int x = 0; x < w; ++x) pass(&tmp[x], &px[x], h, w);
+    }
+}
+
+bool UIManager::captureBackdrop_(SDL_Renderer* renderer, int w, int h) {
+    releaseBackdrop_();
+    if (!SDL_RenderTargetSupported(renderer)) return false;
+    float sx = 1.f, sy = 1.f;
+    SDL_RenderGetScale(renderer, &sx, &sy);
+    if (sx != 1.f || sy != 1.f) return false;
+
+    auto target = UIHelpers::MakeTexture(
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h));
+    if (!target) return false;
+
+    SDL_Texture* prevTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, target.get()) != 0) return false;
+    // Transparent where no element drew, so the app's own drawing under the
+    // UI still shows when the capture is composited.
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    renderScene_(renderer);
+
+    if (backdropMode_ == BlurredBackdrop && blurRadius_ > 0) {
+        std::vector<Uint32> px((size_t)w * h);
+        const bool read = SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888,
+                                               px.data(), w * (int)sizeof(Uint32)) == 0;
+        SDL_SetRenderTarget(renderer, prevTarget);
+        if (read) {
+            boxBlurARGB(px, w, h, blurRadius_);
+            auto blurred = UIHelpers::MakeTexture(
+                SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, w, h));
+            if (blurred && SDL_UpdateTexture(blurred.get(), nullptr, px.data(), w * (int)sizeof(Uint32)) == 0)
+                target = std::move(blurred);
+        }
+    } else {
+        SDL_SetRenderTarget(renderer, prevTarget);
+    }
+
+    // Blending onto a cleared target leaves colour premultiplied by alpha,
+    // so composite it as such; plain alpha blending is the fallback.
+    const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(target.get(), premultiplied) != 0)
+        SDL_SetTextureBlendMode(target.get(), SDL_BLENDMODE_BLEND);
+
+    backdrop_ = std::move(target);
+    backdropW_ = w;
+    backdropH_ = h;
+    backdropDirty_ = false;
+    return true;
+}
+
+void UIManager::render(SDL_Renderer* renderer) {
+    const bool popupOpen = activePopup && activePopup->visible;
+    int rw = 0, rh = 0;
+    const bool haveSize = SDL_GetRendererOutputSize(renderer, &rw, &rh) == 0;
+
+    bool fromBackdrop = false;
+    if (popupOpen && backdropMode_ != LiveBackdrop && haveSize && rw > 0 && rh > 0) {
+        if (backdrop_ && !backdropDirty_ && backdropW_ == rw && backdropH_ == rh) fromBackdrop = true;
+        else fromBackdrop = captureBackdrop_(renderer, rw, rh);
+    }
+    if (fromBackdrop) {
+        SDL_Rect full = { 0, 0, rw, rh };
+        SDL_RenderCopy(renderer, backdrop_.get(), nullptr, &full);
+    } else {
+        renderScene_(renderer);
+    }
+
+    if (popupOpen) {
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 150);
 
-        int rw = 0, rh = 0;
-        if (SDL_GetRendererOutputSize(renderer, &rw, &rh) == 0) {
+        if (haveSize) {
             SDL_Rect fullscreen = { 0, 0, rw, rh };
             SDL_RenderFillRect(renderer, &fullscreen);
         }
@@ -343,11 +876,17 @@ void UIManager::render(SDL_Renderer* renderer) {
 }
 
 int UIManager::findFocusIndex_(UIElement* e) {
-    for (int i = 0; i < (int)focusOrder_.size(); ++i)
-        if (focusOrder_[i] == e) return i;
-    return -1;
+    auto it = slotOf_.find(e);
+    if (it == slotOf_.end()) return -1;
+    const int idx = slots_[it->second].focus;
+    if (idx < 0 || idx >= (int)focusOrder_.size() || focusOrder_[idx].index != it->second) return -1;
+    return idx;
+}
+
+UIElement* UIManager::focusedElement_() const {
+    if (focusedIndex_ < 0 || focusedIndex_ >= (int)focusOrder_.size()) return nullptr;
+    return get(focusOrder_[focusedIndex_]);
 }
-static void sendFocusEvent(UIElement* el, int code);
 
 void UIManager::setFocusedIndex_(int idx) {
     if (idx == focusedIndex_) return;
@@ -358,12 +897,11 @@ void UIManager::setFocusedIndex_(int idx) {
         idx = -1;
     }
     
-    if (focusedIndex_ >= 0 && focusedIndex_ < (int)focusOrder_.size())
-        sendFocusEvent(focusOrder_[focusedIndex_], 0xF002);
+    sendNotifyEvent(focusedElement_(), FOCUS_LOST);
     
     focusedIndex_ = -1;
     if (idx >= 0 && idx < (int)focusOrder_.size()) {
         focusedIndex_ = idx;
-        sendFocusEvent(focusOrder_[focusedIndex_], 0xF001);
+        sendNotifyEvent(focusedElement_(), FOCUS_GAIN);
     }
 }
\ No newline at end of file
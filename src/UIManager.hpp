@@ -2,6 +2,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <unordered_map>
 #include "UIElement.hpp"
 #include "UIButton.hpp"
 #include "UITextField.hpp"
@@ -13,19 +14,72 @@
 #include "UIComboBox.hpp"
 #include "UISpinner.hpp"
 #include "UITextArea.hpp"
+#include "UITimerWheel.hpp"
+#include "UIWidgetArena.hpp"
 
-class UIManager {
+// Refers to an element known to a UIManager. Goes stale (resolves to nullptr)
+// once the element is removed, even if its slot is reused.
+struct UIElementHandle {
+    Uint32 index = 0;
+    Uint32 generation = 0;
+    bool operator==(const UIElementHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const UIElementHandle& o) const { return !(*this == o); }
+};
+
+class UIManager : private UIElementObserver {
 public:
     enum ShortcutScope { Global=0, WhenNoTextEditing=1, ModalOnly=2 };
+    // What is drawn under an open popup. Snapshot and Blurred capture the
+    // UIManager's elements once per popup instead of re-rendering them every
+    // frame, and composite the capture over whatever the app drew first.
+    enum PopupBackdrop { LiveBackdrop=0, SnapshotBackdrop=1, BlurredBackdrop=2 };
+    struct PointerState {
+        int x = 0, y = 0;
+        Uint32 buttons = 0;
+        bool valid = false;
+    };
     ~UIManager() noexcept;
 
     void initCursors();
     void cleanupCursors();
-    void addElement(std::shared_ptr<UIElement> el);
+    UIElementHandle addElement(std::shared_ptr<UIElement> el);
+    // Removal is O(1); the element stays alive until the next update() so it
+    // may remove itself from inside its own event handler.
+    bool removeElement(UIElementHandle h);
+    bool removeElement(UIElement* el);
+    UIElement* get(UIElementHandle h) const;
+    UIElementHandle handleOf(UIElement* el) const;
+
+    // Opt-in: create<T>() allocates from per-class pools instead of the heap.
+    // Widgets already created keep their storage when this is toggled.
+    void setUseArena(bool on, size_t slotsPerBlock = 256);
+    UIWidgetArena* arena() { return arena_.get(); }
+    template<class T, class... Args>
+    std::shared_ptr<T> create(Args&&... args) {
+        if (arena_) return arena_->make<T>(std::forward<Args>(args)...);
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
     void showPopup(std::shared_ptr<UIPopup> popup);
     std::shared_ptr<UIPopup> GetActivePopup();
     void closePopup();
-    void checkCursorForElement(const std::shared_ptr<UIElement>& el, SDL_Cursor*& cursorToUse);
+    void setPopupBackdrop(PopupBackdrop mode, int blurRadius = 6);
+
+    // Elements whose bounds (plus a small margin for focus rings) miss the
+    // render viewport/clip are skipped. Update culling uses the viewport of
+    // the previous render and never skips the focused, hovered or captured element.
+    struct CullStats {
+        int drawn = 0;
+        int culled = 0;
+        int updated = 0;
+        int updateCulled = 0;
+    };
+    void setCulling(bool renderCulling, bool updateCulling = false);
+    const CullStats& cullStats() const { return cullStats_; }
+    // Recapture on the next frame, e.g. after changing the scene under a popup.
+    // A captured backdrop is a still: widgets that animate on their own
+    // (UIChart, a following UILogView, the progress bar marquee) freeze under
+    // the popup until this is called. Use LiveBackdrop if that matters.
+    void invalidateBackdrop() { backdropDirty_ = true; }
     void handleEvent(const SDL_Event& e);
     void update(float dt);
     void render(SDL_Renderer* renderer);
@@ -40,39 +94,129 @@ public:
     void setActiveModal(UIElement* m);
     UIElement* activeModal() const;
     void registerShortcut(SDL_Keycode key, Uint16 mods, ShortcutScope scope, std::function<void()> cb);
-    void setActiveComboBox(UIElement* combo) { activeComboBox_ = combo; }
-    UIElement* getActiveComboBox() const { return activeComboBox_; }
+    void setActiveComboBox(UIElement* combo);
+    UIElement* getActiveComboBox() const { return get(activeComboBox_); }
+    const PointerState& pointer() const { return pointer_; }
+    UIElement* hoveredElement() const { return get(hoveredElement_); }
+    UITimerWheel& timers() { return timers_; }
+    // Milliseconds until the next timer is due, -1 if none (SDL_WaitEventTimeout).
+    int nextTimerTimeout() const { return timers_.msUntilNext(); }
 
 private:
     bool tryShortcuts_(const SDL_Event& e);
-    UIElement* hitTestTopMost_(int x, int y);
+    void dispatch_(UIElement* el, const SDL_Event& e);
+    bool bufferBurst_(const SDL_Event& e);
+    void flushBurst_();
+    UIElement* hitTestHover_(int x, int y);
+    void trackPointer_(const SDL_Event& e);
+    void refreshHover_();
+    void setHovered_(UIElement* el);
+    SDL_Cursor* cursorForHovered_();
+    void finishPopupClose_();
     int  findFocusIndex_(UIElement* e);
     void setFocusedIndex_(int idx);
+    UIElement* focusedElement_() const;
+    void tabFocus_(bool backward);
+
+    struct Slot {
+        UIElement* element = nullptr;
+        Uint32 generation = 1;
+        int dense = -1;   // index in elements, -1 for children and popups
+        int focus = -1;   // index in its layer's focus order
+    };
+    std::vector<Slot> slots_;
+    std::vector<Uint32> freeSlots_;
+    std::unordered_map<UIElement*, Uint32> slotOf_;
+    UIElementHandle acquireHandle_(UIElement* el);
+    void releaseTree_(UIElement* el);
+    void compact_();
+
+    // Dense, in z-order. Removed entries are null until compact_() runs.
     std::vector<std::shared_ptr<UIElement>> elements;
+    std::vector<Uint32> elementSlots_;
+    std::vector<std::shared_ptr<UIElement>> graveyard_;
+
+    // Structure-of-arrays mirror of elements (same dense/z order): bounds
+    // and state flags for hit testing and culling without touching the
+    // elements. Written on add/remove and by elementChanged() when a setter
+    // runs; there is no per-frame pass.
+    enum : Uint8 {
+        META_VISIBLE    = 1 << 0,
+        META_ENABLED    = 1 << 1,
+        META_CUSTOM_HIT = 1 << 2,
+        META_CONTAINER  = 1 << 3,
+        META_UPDATE     = 1 << 4,   // wantsFrameUpdate()
+    };
+    struct ElementMeta {
+        std::vector<int> x, y, w, h;
+        std::vector<Uint8> flags;
+        std::vector<Uint8> kind;   // type-derived flags, fixed at add time
+    };
+    ElementMeta meta_;
+    void syncMetaAt_(size_t i);
+    void elementChanged(UIElement* el) override;
+    int hitTestIndex_(int x, int y) const;
+    bool elementsDirty_ = false;
+    bool focusDirty_ = false;
+
     SDL_Cursor* arrowCursor = nullptr;
     SDL_Cursor* handCursor = nullptr;
     SDL_Cursor* ibeamCursor = nullptr;
     bool handCursorActive = false;
     std::shared_ptr<UIPopup> activePopup;
 
-    std::vector<UIElement*> focusOrder_;
+    std::vector<UIElementHandle> focusOrder_;
     int focusedIndex_ = -1;
-    UIElement* mouseCaptured_ = nullptr;
-    UIElement* activeModal_ = nullptr;
-
-    struct Shortcut {
-        SDL_Keycode key;
-        Uint16 mods;
-        int scope;
-        std::function<void()> cb;
-    };
-    std::vector<Shortcut> shortcuts_;
+    UIElementHandle mouseCaptured_;
+    UIElementHandle activeModal_;
+
+    // Keyed by shortcutKey_(keycode, normalized mods, scope).
+    std::unordered_map<Uint64, std::function<void()>> shortcuts_;
+    static Uint64 shortcutKey_(SDL_Keycode key, Uint16 mods, int scope);
     bool cursorsReady = false;
 
     bool pendingPopupClose = false;
     void ensureCursorsInit_();
     void cleanupCursors_();
-    std::vector<UIElement*> savedFocusOrder_;
-    int savedFocusedIndex_ = -1;
-    UIElement* activeComboBox_ = nullptr;
+    struct FocusScope {
+        std::vector<UIElementHandle> order;
+        int focused = -1;
+    };
+    // Focus state of the layers underneath the active popup.
+    std::vector<FocusScope> focusStack_;
+    void pushFocusScope_();
+    void popFocusScope_();
+    void compactFocus_();
+    UIElementHandle activeComboBox_;
+
+    // Input burst pending for burstTarget_, applied by flushBurst_(): either
+    // text or a repeat count for burstKey_, never both.
+    UIElementHandle burstTarget_;
+    std::string burstText_;
+    SDL_KeyboardEvent burstKey_{};
+    int burstRepeats_ = 0;
+
+    PointerState pointer_;
+    PointerState prevPointer_;
+    UIElementHandle hoveredElement_;
+    UIElementHandle pressTarget_;
+    bool hoverDirty_ = false;
+
+    UITimerWheel timers_;
+    std::unique_ptr<UIWidgetArena> arena_;
+
+    void renderScene_(SDL_Renderer* renderer);
+    bool captureBackdrop_(SDL_Renderer* renderer, int w, int h);
+    void releaseBackdrop_();
+    PopupBackdrop backdropMode_ = LiveBackdrop;
+    int blurRadius_ = 6;
+    UIHelpers::UniqueTexture backdrop_;
+    int backdropW_ = 0, backdropH_ = 0;
+    bool backdropDirty_ = true;
+
+    bool cullRender_ = true;
+    bool cullUpdate_ = false;
+    SDL_Rect cullView_{ 0, 0, 0, 0 };
+    bool haveCullView_ = false;
+    CullStats cullStats_;
 };
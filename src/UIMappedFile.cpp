@@ -0,0 +1,104 @@
+#include "UIMappedFile.hpp"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+bool UIMappedFile::open(const std::string& path) {
+    close();
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                           OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (f == INVALID_HANDLE_VALUE) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIMappedFile: cannot open '%s' (error %lu)", path.c_str(), GetLastError());
+        return false;
+    }
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz)) { CloseHandle(f); return false; }
+    file_ = f;
+    size_ = (Uint64)sz.QuadPart;
+    open_ = true;
+    if (size_ == 0) return true;
+
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* p = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!p) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIMappedFile: cannot map '%s' (error %lu)", path.c_str(), GetLastError());
+        if (m) CloseHandle(m);
+        close();
+        return false;
+    }
+    mapping_ = m;
+    data_ = static_cast<const char*>(p);
+    return true;
+}
+
+// A mapped file cannot be truncated or renamed over on Windows; only a
+// shrink through another handle that raced the mapping can show up here.
+bool UIMappedFile::isStale(const std::string& path) const {
+    if (!open_) return false;
+    WIN32_FILE_ATTRIBUTE_DATA a;
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &a)) return false;
+    return (((Uint64)a.nFileSizeHigh << 32) | a.nFileSizeLow) < size_;
+}
+
+void UIMappedFile::close() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_) CloseHandle(file_);
+    data_ = nullptr;
+    mapping_ = file_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+#else
+bool UIMappedFile::open(const std::string& path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIMappedFile: cannot open '%s'", path.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+    size_ = (Uint64)st.st_size;
+    dev_ = (Uint64)st.st_dev;
+    ino_ = (Uint64)st.st_ino;
+    open_ = true;
+    if (size_ == 0) { ::close(fd); return true; }
+
+    void* p = mmap(nullptr, (size_t)size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps the file referenced
+    if (p == MAP_FAILED) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "UIMappedFile: cannot map '%s'", path.c_str());
+        size_ = 0;
+        open_ = false;
+        return false;
+    }
+    madvise(p, (size_t)size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(p);
+    return true;
+}
+
+// A deleted file stays mapped and readable, so only a file that is still
+// there but different or shorter counts.
+bool UIMappedFile::isStale(const std::string& path) const {
+    if (!open_) return false;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    return (Uint64)st.st_dev != dev_ || (Uint64)st.st_ino != ino_ || (Uint64)st.st_size < size_;
+}
+
+void UIMappedFile::close() {
+    if (data_) munmap(const_cast<char*>(data_), (size_t)size_);
+    data_ = nullptr;
+    size_ = 0;
+    dev_ = ino_ = 0;
+    open_ = false;
+}
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are loaded by the OS as
+// they are touched, so opening a multi-gigabyte file is instant.
+class UIMappedFile {
+public:
+    UIMappedFile() = default;
+    ~UIMappedFile() { close(); }
+    UIMappedFile(const UIMappedFile&) = delete;
+    UIMappedFile& operator=(const UIMappedFile&) = delete;
+
+    // Logs and returns false on failure. An empty file maps to size() == 0.
+    bool open(const std::string& path);
+    void close();
+
+    const char* data() const { return data_; }
+    Uint64 size() const { return size_; }
+    bool isOpen() const { return open_; }
+
+    // True if the file at path has shrunk below size() or is no longer the
+    // file that was mapped. After a truncation, touching pages past the new
+    // end raises SIGBUS on POSIX systems, so callers should re-open.
+    bool isStale(const std::string& path) const;
+
+private:
+    const char* data_ = nullptr;
+    Uint64 size_ = 0;
+    bool open_ = false;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    Uint64 dev_ = 0, ino_ = 0;
+#endif
+};
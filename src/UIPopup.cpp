@@ -4,11 +4,33 @@ UIPopup::UIPopup(int x, int y, int w, int h) {
     bounds = { x, y, w, h };
 }
 
+UIPopup::~UIPopup() {
+    for (auto& child : children)
+        if (child && child->parent() == this) child->setParent(nullptr);
+}
+
 void UIPopup::addChild(std::shared_ptr<UIElement> el) {
+    if (el) {
+        el->attachTimers(timers);
+        el->setParent(this);
+    }
     children.push_back(el);
+    markDirty();
+}
+
+void UIPopup::markDirty() {
+    layer.invalidate();
+    UIElement::markDirty();
+}
+
+void UIPopup::attachTimers(UITimerWheel* wheel) {
+    UIElement::attachTimers(wheel);
+    for (auto& child : children)
+        if (child) child->attachTimers(wheel);
 }
 
 void UIPopup::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT && (e.user.code == 0xF003 || e.user.code == 0xF004)) return;
     for (auto& child : children) {
         if (child)  child->handleEvent(e);
     }
@@ -16,15 +38,21 @@ void UIPopup::handleEvent(const SDL_Event& e) {
 
 void UIPopup::update(float dt) {
     for (auto& child : children) {
-        child->update(dt);
+        if (child->wantsFrameUpdate()) child->update(dt);
     }
 }
 
 void UIPopup::render(SDL_Renderer* renderer)
 {
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const PopupStyle st = MakePopupStyle(th, ds);
+    if (layer.render(renderer, bounds, UIConfig::lookGeneration(),
+                     [this](SDL_Renderer* r) { paint_(r); }))
+        return;
+    paint_(renderer);
+}
+
+void UIPopup::paint_(SDL_Renderer* renderer)
+{
+    const PopupStyle st = resolvedStyle<PopupStyle>();
 
     const SDL_Rect r = bounds;
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "UIElement.hpp"
+#include "UILayerCache.hpp"
 #include <vector>
 #include <memory>
 #include <SDL2/SDL.h>
@@ -7,12 +8,20 @@
 class UIPopup : public UIElement {
 public:
     UIPopup(int x, int y, int w, int h);
+    ~UIPopup() override;
     void addChild(std::shared_ptr<UIElement> el);
     void handleEvent(const SDL_Event& e) override;
     void update(float dt) override;
     void render(SDL_Renderer* renderer) override;
+    void attachTimers(UITimerWheel* wheel) override;
+    void markDirty() override;
+
+    // Opt-in: see UIGroupBox::setLayerCached.
+    void setLayerCached(bool on) { layer.setEnabled(on); }
+    bool isLayerCached() const { return layer.isEnabled(); }
+    const UILayerCache& layerCache() const { return layer; }
     int getPadFromTheme() const {
-        return MakePopupStyle(getTheme(), getStyle()).pad;
+        return resolvedStyle<PopupStyle>().pad;
     }
     void centerInRenderer(SDL_Renderer* r) {
         if (!r) return;
@@ -23,5 +32,8 @@ public:
     }
 
     std::vector<std::shared_ptr<UIElement>> children;
-    
+
+private:
+    UILayerCache layer;
+    void paint_(SDL_Renderer* renderer);
 };
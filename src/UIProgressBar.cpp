@@ -1,6 +1,8 @@
 #include "UIProgressBar.hpp"
 #include <cmath>
 
+static constexpr Uint32 MARQUEE_TICK_MS = 16;
+
 UIProgressBar::UIProgressBar(int x, int y, int w, int h, float& bind)
     : linked(bind)
 {
@@ -12,6 +14,7 @@ UIProgressBar::~UIProgressBar() {}
 UIProgressBar* UIProgressBar::setRange(float mn, float mx) {
     if (mx < mn) std::swap(mn, mx);
     minV = mn; maxV = mx;
+    markDirty();
     return this;
 }
 
@@ -23,26 +26,31 @@ UIProgressBar* UIProgressBar::setValue(float v) {
 
 UIProgressBar* UIProgressBar::setBuffer(float v) {
     bufferV = v;
+    markDirty();
     return this;
 }
 
 UIProgressBar* UIProgressBar::setIndeterminate(bool b) {
     indeterminate = b;
+    markDirty();
     return this;
 }
 
 UIProgressBar* UIProgressBar::setOrientation(UIProgressOrientation o) {
     orient = o;
+    markDirty();
     return this;
 }
 
 UIProgressBar* UIProgressBar::setShowText(bool b) {
     showText = b;
+    markDirty();
     return this;
 }
 
 UIProgressBar* UIProgressBar::setTextFormatter(std::function<std::string(float)> f) {
     formatter = std::move(f);
+    markDirty();
     return this;
 }
 
@@ -53,13 +61,14 @@ void UIProgressBar::rebuildText(SDL_Renderer* r, TTF_Font* f, const std::string&
         cachedW = cachedH = 0; 
         return; 
     }
-    if (cachedTex && s == cachedStr) return;
+    const LookStamp look = lookStamp();
+    if (cachedTex && s == cachedStr && cachedLook == look) return;
 
     cachedTex.reset(nullptr);
     cachedStr = s;
+    cachedLook = look;
     
-    const UITheme& th = getTheme();
-    const auto st = MakeProgressStyle(th, getStyle());
+    const auto st = resolvedStyle<::UIProgressStyle>();
     SDL_Color col = st.text;
     
     auto surf = UIHelpers::MakeSurface(TTF_RenderUTF8_Blended(f, s.c_str(), col));
@@ -73,17 +82,31 @@ void UIProgressBar::rebuildText(SDL_Renderer* r, TTF_Font* f, const std::string&
 }
 
 void UIProgressBar::update(float dt) {
-    if (!enabled) return;
-    if (indeterminate) {
-        marquee += std::max(0.0f, dt) * marqueeSpeed;
-        if (marquee >= 1.f) marquee -= std::floor(marquee);
+    // The bound value changes behind our back; report it to cached layers.
+    if (linked.get() != seenValue || bufferV != seenBuffer) {
+        seenValue = linked.get();
+        seenBuffer = bufferV;
+        markDirty();
+    }
+    if (!enabled || !indeterminate) {
+        if (marqueeTimer != UITimerWheel::InvalidTimer) {
+            if (timers) timers->cancel(marqueeTimer);
+            marqueeTimer = UITimerWheel::InvalidTimer;
+        }
+        return;
     }
+    marquee += std::max(0.0f, dt) * marqueeSpeed;
+    if (marquee >= 1.f) marquee -= std::floor(marquee);
+    markDirty();
+    // The timer does no work itself; it keeps nextTimerTimeout() short so a
+    // waiting event loop still produces frames while the marquee animates.
+    if (timers && !timers->isActive(marqueeTimer))
+        marqueeTimer = timers->every(this, MARQUEE_TICK_MS, []{});
 }
 
 void UIProgressBar::render(SDL_Renderer* renderer) {
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st     = MakeProgressStyle(th, ds);
+    const auto st     = resolvedStyle<::UIProgressStyle>();
 
     const int effRadius   = (cornerRadius >= 0 ? cornerRadius : st.radius);
     const int effBorderPx = (borderPx     >= 0 ? borderPx     : st.borderPx);
@@ -25,8 +25,8 @@ public:
     UIProgressBar* setOrientation(UIProgressOrientation o);
     UIProgressBar* setShowText(bool b);
     UIProgressBar* setTextFormatter(std::function<std::string(float)> f);
-    UIProgressBar* setCornerRadius(int r) { cornerRadius = (r < 0 ? 0 : r); return this; }
-    UIProgressBar* setBorderThickness(int px) { borderPx = (px < 0 ? 0 : px); return this; }
+    UIProgressBar* setCornerRadius(int r) { cornerRadius = (r < 0 ? 0 : r); markDirty(); return this; }
+    UIProgressBar* setBorderThickness(int px) { borderPx = (px < 0 ? 0 : px); markDirty(); return this; }
     UIProgressBar* setFocusable(bool f) { focusable = f; return this; }
     
     float value() const { return linked.get(); }
@@ -55,7 +55,10 @@ private:
     float bufferV = -1.f;
     bool  indeterminate = false;
     float marquee = 0.f;
+    float seenValue = 0.f;
+    float seenBuffer = -1.f;
     float marqueeSpeed = 0.9f;
+    UITimerWheel::TimerId marqueeTimer = UITimerWheel::InvalidTimer;
 
     UIProgressOrientation orient = UIProgressOrientation::Horizontal;
     bool  showText   = false;
@@ -67,6 +70,7 @@ private:
 
     mutable UIHelpers::UniqueTexture cachedTex{ nullptr };
     mutable std::string cachedStr;
+    mutable LookStamp cachedLook;
     mutable int cachedW = 0, cachedH = 0;
 
     void rebuildText(SDL_Renderer* r, TTF_Font* f, const std::string& s) const;
@@ -9,7 +9,7 @@ UIRadioButton::UIRadioButton(const std::string& label, int x, int y, int w, int
     bounds = { x, y, w, h };
 }
 
-void UIRadioButton::setFont(TTF_Font* f) { font = f; }
+void UIRadioButton::setFont(TTF_Font* f) { font = f; markDirty(); }
 int  UIRadioButton::getID() const { return id; }
 bool UIRadioButton::isHovered() const { return hovered; }
 
@@ -23,6 +23,8 @@ void UIRadioButton::handleEvent(const SDL_Event& e) {
             focused = false;
             return;
         }
+        if (e.user.code == 0xF003) { hovered = enabled; return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
     }
 
     if (!enabled) return;
@@ -47,17 +49,13 @@ void UIRadioButton::handleEvent(const SDL_Event& e) {
     }
 }
 
-void UIRadioButton::update(float) {
-    if (!enabled) { hovered = false; pressed = false; return; }
-    int mx, my; SDL_GetMouseState(&mx, &my);
-    SDL_Point p{ mx, my };
-    hovered = SDL_PointInRect(&p, &bounds);
+void UIRadioButton::enabledChanged() {
+    if (!enabled) { hovered = false; pressed = false; }
 }
 
 void UIRadioButton::render(SDL_Renderer* renderer) {
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeRadioStyle(th, ds);
+    const auto st = resolvedStyle<UIRadioStyle>();
 
     TTF_Font* activeFont = font ? font : (th.font ? th.font : UIConfig::getDefaultFont());
     if (!activeFont) return;
@@ -12,7 +12,8 @@ public:
     UIRadioButton(const std::string& label, int x, int y, int w, int h, UIRadioGroup* group, int id, TTF_Font* font = nullptr);
 
     void handleEvent(const SDL_Event& e) override;
-    void update(float dt) override;
+    void update(float) override {}
+    bool wantsFrameUpdate() const override { return false; }
     void render(SDL_Renderer* renderer) override;
     bool isHovered() const override;
     bool isFocusable() const override { return true; }
@@ -23,6 +24,9 @@ public:
     UIRadioButton* setFocusable(bool f) { focusable = f; return this; }
     bool isFocused() const { return focused; }
 
+protected:
+    void enabledChanged() override;
+
 private:
     std::string label;
     int id;
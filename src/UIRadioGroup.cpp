@@ -5,7 +5,9 @@ void UIRadioGroup::addButton(std::shared_ptr<UIRadioButton> btn) {
 }
 
 void UIRadioGroup::select(int id) {
+    if (selectedID == id) return;
     selectedID = id;
+    for (auto& b : buttons) b->markDirty();
 }
 
 int UIRadioGroup::getSelectedID() const {
@@ -0,0 +1,54 @@
+#include "UISampleRing.hpp"
+#include <algorithm>
+
+UISampleRing::UISampleRing(size_t capacity) {
+    size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    mask_ = cap - 1;
+    data_.reset(new std::atomic<float>[cap]);
+    for (size_t i = 0; i < cap; ++i) data_[i].store(0.f, std::memory_order_relaxed);
+}
+
+void UISampleRing::push(float v) {
+    push(&v, 1);
+}
+
+// Seqlock-style: the claim is made visible before any slot is overwritten
+// (the release fence keeps the data stores from moving above it), and the
+// samples are published through written_ afterwards.
+void UISampleRing::push(const float* v, size_t n) {
+    if (n == 0) return;
+    const Uint64 w = written_.load(std::memory_order_relaxed);
+    claimed_.store(w + n, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < n; ++i) data_[(w + i) & mask_].store(v[i], std::memory_order_relaxed);
+    written_.store(w + n, std::memory_order_release);
+}
+
+// The producer may be overwriting any slot below its claim while we copy, so
+// after the copy only samples newer than claimed - capacity are trusted. If
+// the copy saw any store of a push, the acquire fence makes its claim visible.
+Uint64 UISampleRing::read(Uint64 from, std::vector<float>& out, Uint64* lost) const {
+    const Uint64 cap = capacity();
+    const Uint64 head = written_.load(std::memory_order_acquire);
+    Uint64 start = head > cap ? head - cap : 0;
+    if (from > start) start = from;
+    if (start >= head) { if (lost) *lost = 0; return head; }
+
+    const size_t base = out.size();
+    out.resize(base + (size_t)(head - start));
+    for (Uint64 i = start; i < head; ++i)
+        out[base + (size_t)(i - start)] = data_[i & mask_].load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const Uint64 claimed = claimed_.load(std::memory_order_relaxed);
+    const Uint64 safe = claimed > cap ? claimed - cap : 0;
+    Uint64 skipped = start - from;
+    if (start < safe) {
+        const Uint64 torn = std::min(safe, head) - start;
+        out.erase(out.begin() + base, out.begin() + base + (size_t)torn);
+        skipped += torn;
+    }
+    if (lost) *lost = skipped;
+    return head;
+}
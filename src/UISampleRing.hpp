@@ -0,0 +1,36 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Single-producer ring of float samples. push() never blocks or allocates
+// and overwrites the oldest sample when full; readers copy out whatever is
+// still in the ring and drop anything the producer lapped while copying.
+// One producer thread, any number of readers.
+class UISampleRing {
+public:
+    // Rounded up to a power of two.
+    explicit UISampleRing(size_t capacity = 1 << 16);
+    UISampleRing(const UISampleRing&) = delete;
+    UISampleRing& operator=(const UISampleRing&) = delete;
+
+    void push(float v);
+    void push(const float* v, size_t n);
+
+    size_t capacity() const { return mask_ + 1; }
+    // Total samples ever pushed; sample i lives in the ring while i >= written() - capacity().
+    Uint64 written() const { return written_.load(std::memory_order_acquire); }
+
+    // Appends samples [from, written()) that are still intact to out and
+    // returns the new cursor. Skipped samples are reported in *lost.
+    Uint64 read(Uint64 from, std::vector<float>& out, Uint64* lost = nullptr) const;
+
+private:
+    size_t mask_;
+    std::unique_ptr<std::atomic<float>[]> data_;
+    std::atomic<Uint64> written_{ 0 };
+    // Advanced before a push touches the ring, so readers know which slots
+    // may be mid-overwrite even when a batch spans many of them.
+    std::atomic<Uint64> claimed_{ 0 };
+};
@@ -0,0 +1,124 @@
+#include "UIScrollBars.hpp"
+#include <algorithm>
+#include <cmath>
+
+static constexpr int MIN_THUMB_PX = 20;
+static constexpr int WHEEL_X_PX   = 48;
+
+// Each bar shrinks the other axis, so settle in two passes.
+UIScrollBars::Layout UIScrollBars::layout(const SDL_Rect& area, double contentW, double contentH) const {
+    Layout l;
+    l.content[0] = contentW;
+    l.content[1] = contentH;
+    bool h = false, v = false;
+    for (int pass = 0; pass < 2; ++pass) {
+        h = axes_[0] && contentW > area.w - (v ? BAR_PX : 0);
+        v = axes_[1] && contentH > area.h - (h ? BAR_PX : 0);
+    }
+    l.bar[0] = h;
+    l.bar[1] = v;
+    l.view = { area.x, area.y, std::max(0, area.w - (v ? BAR_PX : 0)), std::max(0, area.h - (h ? BAR_PX : 0)) };
+    return l;
+}
+
+SDL_Rect UIScrollBars::track(const Layout& l, int axis) const {
+    return axis == 1 ? SDL_Rect{ l.view.x + l.view.w, l.view.y, BAR_PX, l.view.h }
+                     : SDL_Rect{ l.view.x, l.view.y + l.view.h, l.view.w, BAR_PX };
+}
+
+SDL_Rect UIScrollBars::thumb(const Layout& l, int axis) const {
+    const SDL_Rect t = track(l, axis);
+    const int len = axis == 1 ? t.h : t.w;
+    const double content = l.content[axis];
+    const int th = content > 0.0 ? std::min(len, std::max(MIN_THUMB_PX, (int)(len * (len / content)))) : len;
+    const double maxS = maxOffset(l, axis);
+    const int off = maxS > 0.0 ? (int)std::lround((len - th) * (offset_[axis] / maxS)) : 0;
+    return axis == 1 ? SDL_Rect{ t.x + 2, t.y + off, t.w - 4, th }
+                     : SDL_Rect{ t.x + off, t.y + 2, th, t.h - 4 };
+}
+
+double UIScrollBars::maxOffset(const Layout& l, int axis) const {
+    if (!axes_[axis]) return 0.0;
+    return std::max(0.0, l.content[axis] - (axis == 1 ? l.view.h : l.view.w));
+}
+
+bool UIScrollBars::setOffset(const Layout& l, int axis, double v) {
+    v = std::clamp(v, 0.0, maxOffset(l, axis));
+    if (v == offset_[axis]) return false;
+    offset_[axis] = v;
+    return true;
+}
+
+double UIScrollBars::reveal(const Layout& l, int axis, double pos, double len) const {
+    const double viewLen = axis == 1 ? l.view.h : l.view.w;
+    if (pos < offset_[axis]) return pos;
+    if (pos + len > offset_[axis] + viewLen) return pos + len - viewLen;
+    return offset_[axis];
+}
+
+size_t UIScrollBars::rowAt(const Layout& l, int x, int y, int rowH, size_t rows) const {
+    const SDL_Point p{ x, y };
+    if (!SDL_PointInRect(&p, &l.view)) return npos;
+    const size_t i = (size_t)((offset_[1] + (y - l.view.y)) / std::max(1, rowH));
+    return i < rows ? i : npos;
+}
+
+bool UIScrollBars::handleMouse(const SDL_Event& e, const Layout& l, double lineStep, const ScrollFn& scrollTo) {
+    if (e.type == SDL_MOUSEWHEEL) {
+        if (axes_[0] && e.wheel.x != 0) scrollTo(0, offset_[0] + (double)e.wheel.x * WHEEL_X_PX);
+        if (e.wheel.y != 0) {
+            if (axes_[0] && (SDL_GetModState() & KMOD_SHIFT)) scrollTo(0, offset_[0] - (double)e.wheel.y * WHEEL_X_PX);
+            else if (axes_[1]) scrollTo(1, offset_[1] - (double)e.wheel.y * lineStep);
+        }
+        return true;
+    }
+
+    if (e.type == SDL_MOUSEMOTION) {
+        if (dragAxis_ < 0) return false;
+        const SDL_Rect t = track(l, dragAxis_), th = thumb(l, dragAxis_);
+        const int range = dragAxis_ == 1 ? t.h - th.h : t.w - th.w;
+        const int pos = dragAxis_ == 1 ? e.motion.y : e.motion.x;
+        if (range > 0) scrollTo(dragAxis_, dragStartOffset_ + (pos - dragStartMouse_) * maxOffset(l, dragAxis_) / range);
+        return true;
+    }
+
+    if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
+        if (dragAxis_ < 0) return false;
+        dragAxis_ = -1;
+        return true;
+    }
+
+    if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+        const SDL_Point p{ e.button.x, e.button.y };
+        for (int axis = 0; axis < 2; ++axis) {
+            if (!l.bar[axis]) continue;
+            const SDL_Rect t = track(l, axis);
+            if (!SDL_PointInRect(&p, &t)) continue;
+            const SDL_Rect th = thumb(l, axis);
+            const int pos = axis == 1 ? p.y : p.x;
+            const int lo = axis == 1 ? th.y : th.x, len = axis == 1 ? th.h : th.w;
+            if (pos >= lo && pos < lo + len) {
+                dragAxis_ = axis;
+                dragStartMouse_ = pos;
+                dragStartOffset_ = offset_[axis];
+            } else {
+                const double page = axis == 1 ? l.view.h : l.view.w;
+                scrollTo(axis, offset_[axis] + (pos < lo ? -page : page));
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void UIScrollBars::render(SDL_Renderer* r, const Layout& l, SDL_Color trackColor, SDL_Color thumbColor) const {
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    for (int axis = 0; axis < 2; ++axis) {
+        if (!l.bar[axis]) continue;
+        const SDL_Rect t = track(l, axis), th = thumb(l, axis);
+        SDL_SetRenderDrawColor(r, trackColor.r, trackColor.g, trackColor.b, 150);
+        SDL_RenderFillRect(r, &t);
+        SDL_SetRenderDrawColor(r, thumbColor.r, thumbColor.g, thumbColor.b, dragAxis_ == axis ? 255 : 200);
+        SDL_RenderFillRect(r, &th);
+    }
+}
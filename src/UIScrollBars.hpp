@@ -0,0 +1,55 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <functional>
+
+// Scroll offsets and scrollbars for a viewport over larger content, shared
+// by the list, tree, table and log widgets. The owner describes the area
+// inside its border and the content size with layout(), cheap enough to
+// call per event, and applies offsets through its own setter so it can
+// repaint (or stop following a tail) when they change.
+class UIScrollBars {
+public:
+    static constexpr int BAR_PX = 10;
+    static constexpr size_t npos = (size_t)-1;
+    using ScrollFn = std::function<void(int axis, double offset)>;
+
+    struct Layout {
+        SDL_Rect view{ 0, 0, 0, 0 };      // area minus the bars shown
+        bool bar[2] = { false, false };   // x, y
+        double content[2] = { 0.0, 0.0 };
+    };
+
+    // An axis that cannot scroll never shows a bar.
+    explicit UIScrollBars(bool scrollX = true, bool scrollY = true) : axes_{ scrollX, scrollY } {}
+
+    Layout layout(const SDL_Rect& area, double contentW, double contentH) const;
+    SDL_Rect track(const Layout& l, int axis) const;
+    SDL_Rect thumb(const Layout& l, int axis) const;
+    double maxOffset(const Layout& l, int axis) const;
+
+    double offset(int axis) const { return offset_[axis]; }
+    // Clamped to the layout; false if the offset did not change.
+    bool setOffset(const Layout& l, int axis, double v);
+    void reset() { offset_[0] = offset_[1] = 0.0; dragAxis_ = -1; }
+    // Offset that brings [pos, pos + len) into view with the least movement.
+    double reveal(const Layout& l, int axis, double pos, double len) const;
+    // Row under (x, y) for rows of equal height, or npos.
+    size_t rowAt(const Layout& l, int x, int y, int rowH, size_t rows) const;
+
+    // Wheel (lineStep pixels per notch; shift or a horizontal wheel scrolls
+    // x), thumb drags and page clicks on a track. True if the event was
+    // used; new offsets are passed to scrollTo.
+    bool handleMouse(const SDL_Event& e, const Layout& l, double lineStep, const ScrollFn& scrollTo);
+    bool isDragging() const { return dragAxis_ >= 0; }
+    void cancelDrag() { dragAxis_ = -1; }
+
+    // The tracks lie outside the view; draw with the owner's clip restored.
+    void render(SDL_Renderer* r, const Layout& l, SDL_Color trackColor, SDL_Color thumbColor) const;
+
+private:
+    bool axes_[2];
+    double offset_[2] = { 0.0, 0.0 };
+    int dragAxis_ = -1;
+    int dragStartMouse_ = 0;
+    double dragStartOffset_ = 0.0;
+};
@@ -0,0 +1,476 @@
+#include "UIScrollView.hpp"
+#include <algorithm>
+#include <cmath>
+
+static constexpr int    SCROLLBAR_PX        = 10;
+static constexpr int    MIN_THUMB_PX        = 20;
+static constexpr float  WHEEL_STEP_PX       = 48.f;
+static constexpr float  WHEEL_VELOCITY      = 900.f;   // px/s added per notch
+static constexpr float  MAX_VELOCITY        = 6000.f;
+static constexpr float  FRICTION            = 6.f;     // 1/s, exponential decay
+static constexpr float  STOP_VELOCITY       = 8.f;
+static constexpr float  SNAP_RATE           = 14.f;    // 1/s, animated scrollTo
+static constexpr Uint32 MOTION_TICK_MS      = 16;
+static constexpr long long CACHE_PIXEL_BUDGET = 4096LL * 2048LL;
+static constexpr int    DAMAGE_MARGIN       = 8;       // focus rings draw outside bounds
+
+static void sendNotify(UIElement* el, int code) {
+    if (!el) return;
+    SDL_Event ev{};
+    ev.type = SDL_USEREVENT;
+    ev.user.code = code;
+    ev.user.data1 = el;
+    el->handleEvent(ev);
+    el->markDirty();
+}
+
+UIScrollView::UIScrollView(int x, int y, int w, int h) {
+    bounds = { x, y, w, h };
+    contentCache.setEnabled(true);
+}
+
+UIScrollView::~UIScrollView() {
+    for (auto& child : children)
+        if (child && child->parent() == this) child->setParent(nullptr);
+}
+
+void UIScrollView::addChild(std::shared_ptr<UIElement> child) {
+    if (!child) return;
+    child->attachTimers(timers);
+    child->setParent(this);
+    if (child->isFocusable()) hasFocusable = true;
+    children.push_back(std::move(child));
+    painted.push_back({ 0, 0, 0, 0 });
+    if (autoContent) recomputeContent_();
+    childDamaged(children.back().get());
+}
+
+void UIScrollView::attachTimers(UITimerWheel* wheel) {
+    UIElement::attachTimers(wheel);
+    motionTimer = UITimerWheel::InvalidTimer;
+    for (auto& child : children)
+        if (child) child->attachTimers(wheel);
+}
+
+// Repaints where the child is now and where it was last drawn, in case it
+// moved; anything else (nullptr, an unknown child) repaints everything.
+void UIScrollView::childDamaged(UIElement* child) {
+    auto it = std::find_if(children.begin(), children.end(),
+                           [child](const std::shared_ptr<UIElement>& c) { return child && c.get() == child; });
+    if (it == children.end()) {
+        contentCache.invalidate();
+    } else {
+        auto grow = [](SDL_Rect r) {
+            if (r.w <= 0 || r.h <= 0) return r;
+            return SDL_Rect{ r.x - DAMAGE_MARGIN, r.y - DAMAGE_MARGIN, r.w + 2 * DAMAGE_MARGIN, r.h + 2 * DAMAGE_MARGIN };
+        };
+        contentCache.invalidate(grow(child->bounds));
+        contentCache.invalidate(grow(painted[it - children.begin()]));
+    }
+    UIElement::markDirty();
+}
+
+void UIScrollView::setContentSize(int w, int h) {
+    autoContent = (w <= 0 || h <= 0);
+    if (autoContent) {
+        recomputeContent_();
+    } else {
+        contentW = w;
+        contentH = h;
+    }
+    clampOffset_();
+    childDamaged(nullptr);
+}
+
+void UIScrollView::setContentCaching(bool on) {
+    contentCache.setEnabled(on);
+    UIElement::markDirty();
+}
+
+void UIScrollView::recomputeContent_() {
+    int w = 0, h = 0;
+    for (const auto& c : children) {
+        if (!c || !c->visible) continue;
+        w = std::max(w, c->bounds.x + c->bounds.w);
+        h = std::max(h, c->bounds.y + c->bounds.h);
+    }
+    if (w != contentW || h != contentH) {
+        contentW = w;
+        contentH = h;
+        clampOffset_();
+        contentCache.invalidate();
+    }
+}
+
+bool UIScrollView::needsVBar_() const {
+    return contentH > bounds.h || (contentW > bounds.w && contentH > bounds.h - SCROLLBAR_PX);
+}
+
+bool UIScrollView::needsHBar_() const {
+    return contentW > bounds.w || (contentH > bounds.h && contentW > bounds.w - SCROLLBAR_PX);
+}
+
+SDL_Rect UIScrollView::viewRect_() const {
+    SDL_Rect v = bounds;
+    if (needsVBar_()) v.w = std::max(0, v.w - SCROLLBAR_PX);
+    if (needsHBar_()) v.h = std::max(0, v.h - SCROLLBAR_PX);
+    return v;
+}
+
+float UIScrollView::maxOffset_(int axis) const {
+    const SDL_Rect v = viewRect_();
+    return axis == 0 ? (float)std::max(0, contentW - v.w) : (float)std::max(0, contentH - v.h);
+}
+
+void UIScrollView::clampOffset_() {
+    offX = std::clamp(offX, 0.f, maxOffset_(0));
+    offY = std::clamp(offY, 0.f, maxOffset_(1));
+    targetX = std::clamp(targetX, 0.f, maxOffset_(0));
+    targetY = std::clamp(targetY, 0.f, maxOffset_(1));
+}
+
+// Scrolling only changes which part of the content is shown, so it
+// damages this element but not the cached content.
+void UIScrollView::offsetChanged_() {
+    UIElement::markDirty();
+}
+
+void UIScrollView::keepMoving_() {
+    // No work in the callback; it keeps the event loop producing frames.
+    if (timers && !timers->isActive(motionTimer))
+        motionTimer = timers->every(this, MOTION_TICK_MS, []{});
+}
+
+void UIScrollView::scrollTo(float x, float y, bool animate) {
+    velX = velY = 0.f;
+    targetX = std::clamp(x, 0.f, maxOffset_(0));
+    targetY = std::clamp(y, 0.f, maxOffset_(1));
+    if (animate) {
+        animating = true;
+        keepMoving_();
+        return;
+    }
+    animating = false;
+    if (targetX != offX || targetY != offY) {
+        offX = targetX;
+        offY = targetY;
+        offsetChanged_();
+    }
+}
+
+void UIScrollView::scrollBy(float dx, float dy) {
+    scrollTo(offX + dx, offY + dy, false);
+}
+
+void UIScrollView::ensureVisible(const SDL_Rect& r, bool animate) {
+    const SDL_Rect v = viewRect_();
+    float x = offX, y = offY;
+    if (r.x < x) x = (float)r.x;
+    else if (r.x + r.w > x + v.w) x = (float)(r.x + r.w - v.w);
+    if (r.y < y) y = (float)r.y;
+    else if (r.y + r.h > y + v.h) y = (float)(r.y + r.h - v.h);
+    if (x != offX || y != offY) scrollTo(x, y, animate);
+}
+
+SDL_Rect UIScrollView::thumbRect_(int axis) const {
+    const SDL_Rect v = viewRect_();
+    if (axis == 1) {
+        const float ratio = contentH > 0 ? std::min(1.f, (float)v.h / contentH) : 1.f;
+        const int th = std::max(MIN_THUMB_PX, (int)(v.h * ratio));
+        const float maxOff = maxOffset_(1);
+        const int ty = v.y + (maxOff > 0 ? (int)(offY / maxOff * (v.h - th)) : 0);
+        return { v.x + v.w, ty, SCROLLBAR_PX, th };
+    }
+    const float ratio = contentW > 0 ? std::min(1.f, (float)v.w / contentW) : 1.f;
+    const int tw = std::max(MIN_THUMB_PX, (int)(v.w * ratio));
+    const float maxOff = maxOffset_(0);
+    const int tx = v.x + (maxOff > 0 ? (int)(offX / maxOff * (v.w - tw)) : 0);
+    return { tx, v.y + v.h, tw, SCROLLBAR_PX };
+}
+
+std::shared_ptr<UIElement> UIScrollView::childAt_(int cx, int cy) const {
+    for (int i = (int)children.size() - 1; i >= 0; --i) {
+        const auto& c = children[i];
+        if (c && c->visible && c->isInside(cx, cy)) return c;
+    }
+    return nullptr;
+}
+
+SDL_Event UIScrollView::toContent_(const SDL_Event& e) const {
+    const SDL_Rect v = viewRect_();
+    const int dx = (int)std::lround(offX) - v.x;
+    const int dy = (int)std::lround(offY) - v.y;
+    SDL_Event out = e;
+    if (e.type == SDL_MOUSEMOTION) {
+        out.motion.x += dx;
+        out.motion.y += dy;
+    } else if (e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP) {
+        out.button.x += dx;
+        out.button.y += dy;
+    }
+    return out;
+}
+
+void UIScrollView::forward_(UIElement* child, const SDL_Event& e) {
+    if (!child) return;
+    child->handleEvent(e);
+    if (e.type != SDL_MOUSEMOTION || e.motion.state || child->isInside(e.motion.x, e.motion.y))
+        child->markDirty();
+}
+
+void UIScrollView::setFocusChild_(const std::shared_ptr<UIElement>& c) {
+    const auto old = focusChild.lock();
+    if (c == old) return;
+    focusChild = c;
+    if (old) sendNotify(old.get(), 0xF002);
+    if (c) {
+        sendNotify(c.get(), 0xF001);
+        ensureVisible(c->bounds);
+    }
+}
+
+void UIScrollView::setHoverChild_(const std::shared_ptr<UIElement>& c) {
+    const auto old = hoverChild.lock();
+    if (c == old) return;
+    hoverChild = c;
+    if (old) sendNotify(old.get(), 0xF004);
+    if (c) sendNotify(c.get(), 0xF003);
+}
+
+bool UIScrollView::handleScrollbar_(const SDL_Event& e) {
+    if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+        const SDL_Point p{ e.button.x, e.button.y };
+        for (int axis = 0; axis < 2; ++axis) {
+            if (axis == 0 ? !needsHBar_() : !needsVBar_()) continue;
+            const SDL_Rect v = viewRect_();
+            const SDL_Rect track = axis == 1 ? SDL_Rect{ v.x + v.w, v.y, SCROLLBAR_PX, v.h }
+                                             : SDL_Rect{ v.x, v.y + v.h, v.w, SCROLLBAR_PX };
+            if (!SDL_PointInRect(&p, &track)) continue;
+            const SDL_Rect thumb = thumbRect_(axis);
+            if (!SDL_PointInRect(&p, &thumb)) {
+                // Page towards the click.
+                const bool before = axis == 1 ? p.y < thumb.y : p.x < thumb.x;
+                const float page = (float)(axis == 1 ? v.h : v.w) * (before ? -1.f : 1.f);
+                if (axis == 1) scrollTo(offX, offY + page, kinetic);
+                else           scrollTo(offX + page, offY, kinetic);
+            }
+            dragAxis = axis;
+            dragStartMouse = axis == 1 ? p.y : p.x;
+            dragStartOffset = axis == 1 ? targetY : targetX;
+            return true;
+        }
+        return false;
+    }
+    if (dragAxis < 0) return false;
+    if (e.type == SDL_MOUSEMOTION) {
+        const SDL_Rect v = viewRect_();
+        const SDL_Rect thumb = thumbRect_(dragAxis);
+        const int trackLen = dragAxis == 1 ? v.h - thumb.h : v.w - thumb.w;
+        const int mouse = dragAxis == 1 ? e.motion.y : e.motion.x;
+        const float perPx = trackLen > 0 ? maxOffset_(dragAxis) / trackLen : 0.f;
+        const float off = dragStartOffset + (mouse - dragStartMouse) * perPx;
+        if (dragAxis == 1) scrollTo(offX, off); else scrollTo(off, offY);
+        return true;
+    }
+    if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
+        dragAxis = -1;
+        return true;
+    }
+    return false;
+}
+
+bool UIScrollView::stepFocus(bool forward, bool fromOutside) {
+    const int n = (int)children.size(), dir = forward ? 1 : -1;
+    int i = forward ? -1 : n;
+    if (!fromOutside) {
+        const std::shared_ptr<UIElement> cur = focusChild.lock();
+        for (int k = 0; cur && k < n; ++k)
+            if (children[k] == cur) { i = k; break; }
+    }
+    for (i += dir; i >= 0 && i < n; i += dir) {
+        const auto& c = children[i];
+        if (c && c->visible && c->enabled && c->isFocusable()) { setFocusChild_(c); return true; }
+    }
+    return false;
+}
+
+void UIScrollView::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        switch (e.user.code) {
+            case 0xF001:
+                if (focusChild.expired()) {
+                    for (auto& c : children)
+                        if (c && c->visible && c->isFocusable()) { setFocusChild_(c); break; }
+                }
+                return;
+            case 0xF002: setFocusChild_(nullptr); return;
+            case 0xF004: setHoverChild_(nullptr); return;
+            default: return;
+        }
+    }
+    if (!enabled) return;
+
+    if (e.type == SDL_MOUSEWHEEL) {
+        const SDL_Point p = lastMouse;
+        if (!SDL_PointInRect(&p, &bounds)) return;
+        const float dx = (float)e.wheel.x, dy = (float)-e.wheel.y;
+        if (kinetic) {
+            animating = false;
+            velX = std::clamp(velX + dx * WHEEL_VELOCITY, -MAX_VELOCITY, MAX_VELOCITY);
+            velY = std::clamp(velY + dy * WHEEL_VELOCITY, -MAX_VELOCITY, MAX_VELOCITY);
+            keepMoving_();
+        } else {
+            scrollBy(dx * WHEEL_STEP_PX, dy * WHEEL_STEP_PX);
+        }
+        return;
+    }
+
+    if (e.type == SDL_MOUSEMOTION) lastMouse = { e.motion.x, e.motion.y };
+    if (handleScrollbar_(e)) return;
+
+    if (e.type == SDL_MOUSEMOTION || e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP) {
+        const SDL_Event ce = toContent_(e);
+        const SDL_Rect v = viewRect_();
+        const SDL_Point p = e.type == SDL_MOUSEMOTION ? SDL_Point{ e.motion.x, e.motion.y }
+                                                      : SDL_Point{ e.button.x, e.button.y };
+        const bool inView = SDL_PointInRect(&p, &v);
+        const int cx = e.type == SDL_MOUSEMOTION ? ce.motion.x : ce.button.x;
+        const int cy = e.type == SDL_MOUSEMOTION ? ce.motion.y : ce.button.y;
+        const std::shared_ptr<UIElement> hit = inView ? childAt_(cx, cy) : nullptr;
+        const std::shared_ptr<UIElement> pressed = pressChild.lock();
+
+        if (e.type == SDL_MOUSEMOTION) {
+            if (!pressed) setHoverChild_(hit);
+            if (pressed) forward_(pressed.get(), ce);
+            else if (auto h = hoverChild.lock()) forward_(h.get(), ce);
+            return;
+        }
+        if (e.type == SDL_MOUSEBUTTONDOWN) {
+            if (!inView) return;
+            pressChild = hit;
+            if (hit && hit->isFocusable()) setFocusChild_(hit);
+            else if (!hit) setFocusChild_(nullptr);
+            forward_(hit.get(), ce);
+            return;
+        }
+        pressChild.reset();
+        forward_(pressed ? pressed.get() : hit.get(), ce);
+        return;
+    }
+
+    // Keyboard, text input and anything else goes to the focused child.
+    if (auto f = focusChild.lock()) forward_(f.get(), e);
+}
+
+void UIScrollView::update(float dt) {
+    if (autoContent) recomputeContent_();
+
+    bool moved = false;
+    if (animating) {
+        const float k = 1.f - std::exp(-SNAP_RATE * dt);
+        offX += (targetX - offX) * k;
+        offY += (targetY - offY) * k;
+        if (std::fabs(targetX - offX) < 0.5f && std::fabs(targetY - offY) < 0.5f) {
+            offX = targetX;
+            offY = targetY;
+            animating = false;
+        }
+        moved = true;
+    } else if (velX != 0.f || velY != 0.f) {
+        offX += velX * dt;
+        offY += velY * dt;
+        const float decay = std::exp(-FRICTION * dt);
+        velX *= decay;
+        velY *= decay;
+        if (std::fabs(velX) < STOP_VELOCITY) velX = 0.f;
+        if (std::fabs(velY) < STOP_VELOCITY) velY = 0.f;
+        if (offX <= 0.f || offX >= maxOffset_(0)) velX = 0.f;
+        if (offY <= 0.f || offY >= maxOffset_(1)) velY = 0.f;
+        clampOffset_();
+        targetX = offX;
+        targetY = offY;
+        moved = true;
+    }
+    if (moved) offsetChanged_();
+    if (!animating && velX == 0.f && velY == 0.f && motionTimer != UITimerWheel::InvalidTimer) {
+        if (timers) timers->cancel(motionTimer);
+        motionTimer = UITimerWheel::InvalidTimer;
+    }
+
+    for (auto& c : children)
+        if (c && c->wantsFrameUpdate()) c->update(dt);
+}
+
+void UIScrollView::paintContent_(SDL_Renderer* r, const SDL_Rect& visible) {
+    for (size_t i = 0; i < children.size(); ++i) {
+        UIElement* c = children[i].get();
+        if (!c || !c->visible) continue;
+        if (!SDL_HasIntersection(&c->bounds, &visible)) continue;
+        // Children may reset the clip rect when they finish.
+        SDL_RenderSetClipRect(r, &visible);
+        c->render(r);
+        painted[i] = c->bounds;
+    }
+}
+
+void UIScrollView::render(SDL_Renderer* renderer) {
+    const SDL_Rect v = viewRect_();
+    if (v.w <= 0 || v.h <= 0) return;
+    const int sx = (int)std::lround(offX), sy = (int)std::lround(offY);
+
+    bool cached = false;
+    if (contentCache.isEnabled() && contentW > 0 && contentH > 0 &&
+        (long long)contentW * contentH <= CACHE_PIXEL_BUDGET) {
+        SDL_RendererInfo info{};
+        const bool fits = SDL_GetRendererInfo(renderer, &info) != 0 ||
+                          ((info.max_texture_width == 0 || contentW <= info.max_texture_width) &&
+                           (info.max_texture_height == 0 || contentH <= info.max_texture_height));
+        if (fits) {
+            const SDL_Rect content{ 0, 0, contentW, contentH };
+            cached = contentCache.refresh(renderer, content, UIConfig::lookGeneration(),
+                                          [this](SDL_Renderer* r) { paintContent_(r, contentCache.paintRect()); });
+        }
+    }
+    if (!cached) contentCache.release();
+
+    if (cached) {
+        SDL_Rect src{ sx, sy, std::min(v.w, contentW - sx), std::min(v.h, contentH - sy) };
+        if (src.w > 0 && src.h > 0) {
+            SDL_Rect dst{ v.x, v.y, src.w, src.h };
+            SDL_RenderCopy(renderer, contentCache.texture(), &src, &dst);
+        }
+    } else {
+        SDL_Rect prevViewport, prevClip;
+        SDL_RenderGetViewport(renderer, &prevViewport);
+        SDL_RenderGetClipRect(renderer, &prevClip);
+        const bool prevClipOn = SDL_RenderIsClipEnabled(renderer);
+
+        // Content (0,0) lands at the view's top-left minus the offset.
+        const SDL_Rect shifted{ prevViewport.x + v.x - sx, prevViewport.y + v.y - sy,
+                                sx + v.w, sy + v.h };
+        SDL_RenderSetViewport(renderer, &shifted);
+        paintContent_(renderer, SDL_Rect{ sx, sy, v.w, v.h });
+
+        SDL_RenderSetViewport(renderer, &prevViewport);
+        SDL_RenderSetClipRect(renderer, prevClipOn ? &prevClip : nullptr);
+    }
+
+    renderScrollbars_(renderer);
+}
+
+void UIScrollView::renderScrollbars_(SDL_Renderer* renderer) {
+    const UITheme& theme = getTheme();
+    const SDL_Rect v = viewRect_();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (int axis = 0; axis < 2; ++axis) {
+        if (axis == 0 ? !needsHBar_() : !needsVBar_()) continue;
+        const SDL_Rect track = axis == 1 ? SDL_Rect{ v.x + v.w, v.y, SCROLLBAR_PX, v.h }
+                                         : SDL_Rect{ v.x, v.y + v.h, v.w, SCROLLBAR_PX };
+        SDL_SetRenderDrawColor(renderer, theme.sliderTrackColor.r, theme.sliderTrackColor.g, theme.sliderTrackColor.b, 150);
+        SDL_RenderFillRect(renderer, &track);
+        const SDL_Rect thumb = thumbRect_(axis);
+        SDL_SetRenderDrawColor(renderer, theme.sliderThumbColor.r, theme.sliderThumbColor.g, theme.sliderThumbColor.b,
+                               dragAxis == axis ? 255 : 200);
+        SDL_RenderFillRect(renderer, &thumb);
+    }
+}
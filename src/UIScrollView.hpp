@@ -0,0 +1,97 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UILayerCache.hpp"
+#include <vector>
+#include <memory>
+
+// Scrolling container. Children are laid out in content coordinates ((0,0)
+// is the top-left of the scrollable area) and never move when the view
+// scrolls: rendering and mouse events go through one translation and clip.
+// Only children intersecting the viewport are drawn, or, when the content
+// fits the texture budget, the whole content is cached once and scrolling
+// just blits a different part of it. A damaged child repaints only its own
+// rectangle of the cached content.
+//
+// Keyboard: Tab and Shift+Tab step through the visible, enabled, focusable
+// children in the order they were added, scrolling each into view; focus
+// leaves the view after the last (or before the first) of them. Other keys
+// and text go to the focused child.
+class UIScrollView : public UIElement {
+public:
+    UIScrollView(int x, int y, int w, int h);
+    ~UIScrollView() override;
+
+    // Add children before adding the view to the UIManager so it knows
+    // whether the view takes keyboard focus.
+    void addChild(std::shared_ptr<UIElement> child);
+    const std::vector<std::shared_ptr<UIElement>>& getChildren() const { return children; }
+
+    // Defaults to the union of the children's bounds; w/h <= 0 restores that.
+    void setContentSize(int w, int h);
+    SDL_Point getContentSize() const { return { contentW, contentH }; }
+
+    void scrollTo(float x, float y, bool animate = false);
+    void scrollBy(float dx, float dy);
+    // Scrolls the least amount needed to show r (content coordinates).
+    void ensureVisible(const SDL_Rect& r, bool animate = true);
+    float scrollX() const { return offX; }
+    float scrollY() const { return offY; }
+
+    // Wheel input adds velocity that decays with dt instead of jumping.
+    void setKinetic(bool on) { kinetic = on; if (!on) velX = velY = 0.f; }
+    void setContentCaching(bool on);
+
+    void handleEvent(const SDL_Event& e) override;
+    bool stepFocus(bool forward, bool fromOutside) override;
+    void update(float dt) override;
+    void render(SDL_Renderer* renderer) override;
+    void attachTimers(UITimerWheel* wheel) override;
+    bool isFocusable() const override { return hasFocusable; }
+
+protected:
+    void childDamaged(UIElement* child) override;
+
+private:
+    std::vector<std::shared_ptr<UIElement>> children;
+    std::vector<SDL_Rect> painted;   // per child, bounds when last drawn
+    int  contentW = 0, contentH = 0;
+    bool autoContent = true;
+    bool hasFocusable = false;
+
+    float offX = 0.f, offY = 0.f;
+    float velX = 0.f, velY = 0.f;
+    float targetX = 0.f, targetY = 0.f;
+    bool  animating = false;
+    bool  kinetic = true;
+    UITimerWheel::TimerId motionTimer = UITimerWheel::InvalidTimer;
+
+    std::weak_ptr<UIElement> focusChild;
+    std::weak_ptr<UIElement> hoverChild;
+    std::weak_ptr<UIElement> pressChild;
+    SDL_Point  lastMouse{ -1, -1 };
+    int  dragAxis = -1;          // 0 = horizontal bar, 1 = vertical bar
+    int  dragStartMouse = 0;
+    float dragStartOffset = 0.f;
+
+    UILayerCache contentCache;
+
+    SDL_Rect viewRect_() const;
+    bool needsVBar_() const;
+    bool needsHBar_() const;
+    SDL_Rect thumbRect_(int axis) const;
+    float maxOffset_(int axis) const;
+    void clampOffset_();
+    void offsetChanged_();
+    void recomputeContent_();
+    void keepMoving_();
+
+    std::shared_ptr<UIElement> childAt_(int cx, int cy) const;
+    SDL_Event toContent_(const SDL_Event& e) const;
+    void forward_(UIElement* child, const SDL_Event& e);
+    void setFocusChild_(const std::shared_ptr<UIElement>& c);
+    void setHoverChild_(const std::shared_ptr<UIElement>& c);
+    bool handleScrollbar_(const SDL_Event& e);
+
+    void paintContent_(SDL_Renderer* r, const SDL_Rect& visible);
+    void renderScrollbars_(SDL_Renderer* r);
+};
@@ -13,6 +13,10 @@ UISlider::UISlider(const std::string& label, int x, int y, int w, int h, float&
 }
 
 void UISlider::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
+    }
     if (!enabled) return;
 
     float range = maxVal - minVal;
@@ -74,15 +78,15 @@ bool UISlider::isHovered() const {
 }
 
 void UISlider::update(float) {
-    int mx, my; SDL_GetMouseState(&mx, &my);
-    hovered = (mx >= bounds.x && mx < bounds.x + bounds.w &&
-               my >= bounds.y && my < bounds.y + bounds.h);
+    // The bound value changes behind our back; report it to cached layers.
+    if (linkedValue.get() != seenValue) {
+        seenValue = linkedValue.get();
+        markDirty();
+    }
 }
 
 void UISlider::render(SDL_Renderer* renderer) {
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeSliderStyle(th, ds);
+    const auto st = resolvedStyle<UISliderStyle>();
 
     const int trackH = st.trackH;
     SDL_Rect track = {
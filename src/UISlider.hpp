@@ -23,6 +23,7 @@ public:
 private:
     std::string label;
     std::reference_wrapper<float> linkedValue;
+    float seenValue = 0.f;
     float minVal = 0.0f, maxVal = 100.0f;
 
     bool hovered = false;
@@ -5,6 +5,9 @@
 #include <sstream>
 #include <iomanip>
 
+static constexpr Uint32 REPEAT_DELAY_MS    = 400;
+static constexpr Uint32 REPEAT_INTERVAL_MS = 100;
+
 UISpinner::UISpinner(int x, int y, int w, int h, int& bind, int min, int max, int step)
     : value(bind), minValue(min), maxValue(max), step(step)
 {
@@ -13,6 +16,7 @@ UISpinner::UISpinner(int x, int y, int w, int h, int& bind, int min, int max, in
 
 void UISpinner::setFont(TTF_Font* f) {
     font = f;
+    markDirty();
 }
 
 void UISpinner::setOnChange(std::function<void(int)> callback) {
@@ -24,6 +28,11 @@ bool UISpinner::isHovered() const {
 }
 
 void UISpinner::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT && e.user.code == 0xF004) {
+        hoveredMinus = hoveredPlus = false;
+        return;
+    }
+
     int mx = e.button.x;
     int my = e.button.y;
     SDL_Point point = { mx, my };
@@ -31,6 +40,13 @@ void UISpinner::handleEvent(const SDL_Event& e) {
     SDL_Rect minusRect = { bounds.x, bounds.y, bounds.h, bounds.h };
     SDL_Rect plusRect = { bounds.x + bounds.w - bounds.h, bounds.y, bounds.h, bounds.h };
 
+    if (e.type == SDL_MOUSEMOTION) {
+        SDL_Point motionPoint = { e.motion.x, e.motion.y };
+        hoveredMinus = SDL_PointInRect(&motionPoint, &minusRect);
+        hoveredPlus  = SDL_PointInRect(&motionPoint, &plusRect);
+        return;
+    }
+
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
         if (SDL_PointInRect(&point, &minusRect)) {
             if (value.get() > minValue) {
@@ -38,58 +54,64 @@ void UISpinner::handleEvent(const SDL_Event& e) {
                 if (onChange) onChange(value.get());
             }
             heldButton = HeldButton::DECREMENT;
-            pressStartTime = SDL_GetTicks();
-            lastStepTime = pressStartTime;
+            startRepeat();
         } else if (SDL_PointInRect(&point, &plusRect)) {
             if (value.get() < maxValue) {
                 value.get() += step;
                 if (onChange) onChange(value.get());
             }
             heldButton = HeldButton::INCREMENT;
-            pressStartTime = SDL_GetTicks();
-            lastStepTime = pressStartTime;
+            startRepeat();
         }
     }
 
     if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
         heldButton = HeldButton::NONE;
+        stopRepeat();
     }
 }
 
 void UISpinner::update(float) {
-    int mx, my;
-    SDL_GetMouseState(&mx, &my);
-    SDL_Point point = { mx, my };
+    // The bound value changes behind our back; report it to cached layers.
+    if (value.get() != seenValue) {
+        seenValue = value.get();
+        markDirty();
+    }
+}
 
-    SDL_Rect minusRect = { bounds.x, bounds.y, bounds.h, bounds.h };
-    SDL_Rect plusRect = { bounds.x + bounds.w - bounds.h, bounds.y, bounds.h, bounds.h };
+void UISpinner::startRepeat() {
+    if (!timers) return;
+    timers->cancel(repeatTimer);
+    repeatTimer = timers->schedule(this, REPEAT_DELAY_MS, REPEAT_INTERVAL_MS, [this]{ repeatStep(); markDirty(); });
+}
 
-    hoveredMinus = SDL_PointInRect(&point, &minusRect);
-    hoveredPlus = SDL_PointInRect(&point, &plusRect);
+void UISpinner::stopRepeat() {
+    if (repeatTimer == UITimerWheel::InvalidTimer) return;
+    if (timers) timers->cancel(repeatTimer);
+    repeatTimer = UITimerWheel::InvalidTimer;
+}
 
-    Uint32 now = SDL_GetTicks();
-    if (heldButton != HeldButton::NONE && now - pressStartTime > 400 && now - lastStepTime > 100) {
-        if (heldButton == HeldButton::INCREMENT && value.get() < maxValue) {
-            int newValue = value.get() + step;
-            if (newValue <= maxValue) {
-                value.get() = newValue;
-                if (onChange) onChange(value.get());
-            }
-        } else if (heldButton == HeldButton::DECREMENT && value.get() > minValue) {
-            int newValue = value.get() - step;
-            if (newValue >= minValue) {
-                value.get() = newValue;
-                if (onChange) onChange(value.get());
-            }
+void UISpinner::repeatStep() {
+    if (heldButton == HeldButton::INCREMENT && value.get() < maxValue) {
+        int newValue = value.get() + step;
+        if (newValue <= maxValue) {
+            value.get() = newValue;
+            if (onChange) onChange(value.get());
+        }
+    } else if (heldButton == HeldButton::DECREMENT && value.get() > minValue) {
+        int newValue = value.get() - step;
+        if (newValue >= minValue) {
+            value.get() = newValue;
+            if (onChange) onChange(value.get());
         }
-        lastStepTime = now;
+    } else {
+        stopRepeat();
     }
 }
 
 void UISpinner::render(SDL_Renderer* renderer) {
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeSpinnerStyle(th, ds);
+    const auto st = resolvedStyle<UISpinnerStyle>();
     TTF_Font* activeFont = font ? font : (th.font ? th.font : UIConfig::getDefaultFont());
     if (!activeFont) return;
 
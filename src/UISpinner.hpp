@@ -16,6 +16,7 @@ class UISpinner : public UIElement {
     
     private:
         std::reference_wrapper<int> value;
+        int seenValue = 0;
         int minValue;
         int maxValue;
         int step;
@@ -25,7 +26,9 @@ class UISpinner : public UIElement {
         std::function<void(int)> onChange;
         enum class HeldButton { NONE, INCREMENT, DECREMENT };
         HeldButton heldButton = HeldButton::NONE;
-        Uint32 pressStartTime = 0;
-        Uint32 lastStepTime = 0;
+        UITimerWheel::TimerId repeatTimer = UITimerWheel::InvalidTimer;
+        void startRepeat();
+        void stopRepeat();
+        void repeatStep();
 };
     
\ No newline at end of file
@@ -25,3 +25,25 @@ UIStyle MakeMinimalStyle() {
     s.padLg = 12;
     return s;
 }
+
+
+namespace {
+int UIStyle::* const kStyleFields[] = {
+    &UIStyle::radiusSm, &UIStyle::radiusMd, &UIStyle::radiusLg,
+    &UIStyle::borderThin, &UIStyle::borderThick,
+    &UIStyle::padSm, &UIStyle::padMd, &UIStyle::padLg,
+};
+}
+
+bool operator==(const UIStyle& a, const UIStyle& b) {
+    for (auto m : kStyleFields)
+        if (a.*m != b.*m) return false;
+    return true;
+}
+
+size_t HashValue(const UIStyle& s) {
+    unsigned long long h = 1469598103934665603ull;
+    for (auto m : kStyleFields)
+        h = (h ^ (unsigned)(s.*m)) * 1099511628211ull;
+    return (size_t)h;
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 struct UIStyle {
     int radiusSm   = 6;
@@ -13,3 +14,7 @@ struct UIStyle {
 
 UIStyle MakeClassicStyle();
 UIStyle MakeMinimalStyle();
+
+bool operator==(const UIStyle& a, const UIStyle& b);
+inline bool operator!=(const UIStyle& a, const UIStyle& b) { return !(a == b); }
+size_t HashValue(const UIStyle& s);
@@ -27,7 +27,17 @@ UITextAreaStyle MakeTextAreaStyle(const UITheme& t, const UIStyle& ds) {
     s.borderHover  = t.borderHoverColor;
     s.borderFocus  = t.focusRing;
     s.selectionBg  = t.selectionBg;
+    s.matchBg      = t.selectionBg;
+    s.matchBg.a    = (Uint8)(t.selectionBg.a / 2);
     s.caret        = t.cursorColor;
+    const bool dark = UIHelpers::RelativeLuma(t.backgroundColor) < 0.2f;
+    s.synKeyword   = dark ? UIHelpers::RGBA(198, 120, 221) : UIHelpers::RGBA(166,  38, 164);
+    s.synString    = dark ? UIHelpers::RGBA(152, 195, 121) : UIHelpers::RGBA( 80, 140,  60);
+    s.synNumber    = dark ? UIHelpers::RGBA(209, 154, 102) : UIHelpers::RGBA(152, 104,   1);
+    s.synComment   = t.placeholderColor;
+    s.synPunct     = t.textColor;
+    s.synKey       = dark ? UIHelpers::RGBA( 97, 175, 239) : UIHelpers::RGBA( 40,  90, 200);
+    s.synSection   = dark ? UIHelpers::RGBA(229, 192, 123) : UIHelpers::RGBA(193, 132,   1);
     return s;
 }
 
@@ -165,6 +175,66 @@ UIProgressStyle MakeProgressStyle(const UITheme& t, const UIStyle& ds) {
     return s;
 }
 
+UIListBoxStyle MakeListBoxStyle(const UITheme& t, const UIStyle& ds) {
+    UIListBoxStyle s;
+    s.radius      = ds.radiusMd;
+    s.borderPx    = ds.borderThin;
+    s.padX        = ds.padMd;
+    s.bg          = t.backgroundColor;
+    s.fg          = t.textColor;
+    s.border      = t.borderColor;
+    s.borderHover = t.borderHoverColor;
+    s.borderFocus = t.focusRing;
+    s.hoverBg     = UIHelpers::PickHoverColor(t.backgroundColor);
+    s.selectedBg  = UIHelpers::Darken(t.backgroundColor, 8);
+    s.selectedFg  = t.textColor;
+    s.scrollTrack = t.sliderTrackColor;
+    s.scrollThumb = t.sliderThumbColor;
+    return s;
+}
+
+UITableStyle MakeTableStyle(const UITheme& t, const UIStyle& ds) {
+    UITableStyle s;
+    s.radius      = ds.radiusMd;
+    s.borderPx    = ds.borderThin;
+    s.padX        = ds.padMd;
+    s.bg          = t.backgroundColor;
+    s.fg          = t.textColor;
+    s.border      = t.borderColor;
+    s.borderHover = t.borderHoverColor;
+    s.borderFocus = t.focusRing;
+    s.headerBg    = UIHelpers::Darken(t.backgroundColor, 6);
+    s.headerFg    = t.textColor;
+    s.grid        = UIHelpers::WithAlpha(t.borderColor, 110);
+    s.hoverBg     = UIHelpers::PickHoverColor(t.backgroundColor);
+    s.selectedBg  = UIHelpers::Darken(t.backgroundColor, 12);
+    s.selectedFg  = t.textColor;
+    s.scrollTrack = t.sliderTrackColor;
+    s.scrollThumb = t.sliderThumbColor;
+    return s;
+}
+
+UIChartStyle MakeChartStyle(const UITheme& t, const UIStyle& ds) {
+    UIChartStyle s;
+    s.radius   = ds.radiusSm;
+    s.borderPx = ds.borderThin;
+    s.pad      = 4;
+    s.track    = UIHelpers::Darken(t.backgroundColor, 15);
+    s.line     = t.sliderThumbColor;
+    s.fill     = UIHelpers::WithAlpha(t.sliderThumbColor, 70);
+    s.border   = t.borderColor;
+    s.grid     = UIHelpers::WithAlpha(t.borderColor, 90);
+    return s;
+}
+
+UIImageStyle MakeImageStyle(const UITheme& t, const UIStyle& ds) {
+    UIImageStyle s;
+    s.radius        = ds.radiusSm;
+    s.placeholder   = UIHelpers::Darken(t.backgroundColor, 10);
+    s.placeholderFg = t.borderColor;
+    return s;
+}
+
 UITextFieldStyle MakeTextFieldStyle(const UITheme& t) { return MakeTextFieldStyle(t, UIConfig::getStyle()); }
 UITextAreaStyle  MakeTextAreaStyle (const UITheme& t) { return MakeTextAreaStyle (t, UIConfig::getStyle()); }
 UIButtonStyle    MakeButtonStyle   (const UITheme& t) { return MakeButtonStyle   (t, UIConfig::getStyle()); }
@@ -174,4 +244,8 @@ UIRadioStyle     MakeRadioStyle    (const UITheme& t) { return MakeRadioStyle
 UIComboBoxStyle  MakeComboBoxStyle (const UITheme& t) { return MakeComboBoxStyle (t, UIConfig::getStyle()); }
 UISpinnerStyle   MakeSpinnerStyle  (const UITheme& t) { return MakeSpinnerStyle  (t, UIConfig::getStyle()); }
 PopupStyle       MakePopupStyle    (const UITheme& th) { return MakePopupStyle    (th, UIConfig::getStyle()); }
-UIProgressStyle MakeProgressStyle(const UITheme& t) { return MakeProgressStyle(t, UIConfig::getStyle()); }
\ No newline at end of file
+UIProgressStyle MakeProgressStyle(const UITheme& t) { return MakeProgressStyle(t, UIConfig::getStyle()); }
+UIListBoxStyle  MakeListBoxStyle (const UITheme& t) { return MakeListBoxStyle (t, UIConfig::getStyle()); }
+UITableStyle    MakeTableStyle   (const UITheme& t) { return MakeTableStyle   (t, UIConfig::getStyle()); }
+UIChartStyle    MakeChartStyle   (const UITheme& t) { return MakeChartStyle   (t, UIConfig::getStyle()); }
+UIImageStyle    MakeImageStyle   (const UITheme& t) { return MakeImageStyle   (t, UIConfig::getStyle()); }
@@ -27,7 +27,16 @@ struct UITextAreaStyle {
     SDL_Color borderHover{};
     SDL_Color borderFocus{};
     SDL_Color selectionBg{};
+    SDL_Color matchBg{};
     SDL_Color caret{};
+    // Syntax highlighting, see UITextArea::setSyntax.
+    SDL_Color synKeyword{};
+    SDL_Color synString{};
+    SDL_Color synNumber{};
+    SDL_Color synComment{};
+    SDL_Color synPunct{};
+    SDL_Color synKey{};
+    SDL_Color synSection{};
 };
 
 struct UIButtonStyle {
@@ -139,6 +148,58 @@ struct UIProgressStyle {
     SDL_Color text{};
 };
 
+struct UIListBoxStyle {
+    int radius   = 10;
+    int borderPx = 1;
+    int padX     = 10;
+    SDL_Color bg{};
+    SDL_Color fg{};
+    SDL_Color border{};
+    SDL_Color borderHover{};
+    SDL_Color borderFocus{};
+    SDL_Color hoverBg{};
+    SDL_Color selectedBg{};
+    SDL_Color selectedFg{};
+    SDL_Color scrollTrack{};
+    SDL_Color scrollThumb{};
+};
+
+struct UITableStyle {
+    int radius   = 10;
+    int borderPx = 1;
+    int padX     = 8;
+    SDL_Color bg{};
+    SDL_Color fg{};
+    SDL_Color border{};
+    SDL_Color borderHover{};
+    SDL_Color borderFocus{};
+    SDL_Color headerBg{};
+    SDL_Color headerFg{};
+    SDL_Color grid{};
+    SDL_Color hoverBg{};
+    SDL_Color selectedBg{};
+    SDL_Color selectedFg{};
+    SDL_Color scrollTrack{};
+    SDL_Color scrollThumb{};
+};
+
+struct UIChartStyle {
+    int radius   = 6;
+    int borderPx = 1;
+    int pad      = 4;
+    SDL_Color track{};
+    SDL_Color line{};
+    SDL_Color fill{};
+    SDL_Color border{};
+    SDL_Color grid{};
+};
+
+struct UIImageStyle {
+    int radius = 6;
+    SDL_Color placeholder{};
+    SDL_Color placeholderFg{};
+};
+
 UITextFieldStyle MakeTextFieldStyle(const UITheme& t, const UIStyle& s);
 UITextAreaStyle  MakeTextAreaStyle (const UITheme& t, const UIStyle& s);
 UIButtonStyle    MakeButtonStyle   (const UITheme& t, const UIStyle& s);
@@ -153,6 +214,62 @@ UILabelStyle     MakeLabelStyle    (const UITheme& th, const UIStyle&);
 UILabelStyle     MakeLabelStyle    (const UITheme& th);
 PopupStyle       MakePopupStyle    (const UITheme& th, const UIStyle& s);
 UIProgressStyle MakeProgressStyle(const UITheme& t, const UIStyle& s);
+UIListBoxStyle  MakeListBoxStyle (const UITheme& t, const UIStyle& s);
+UITableStyle    MakeTableStyle   (const UITheme& t, const UIStyle& s);
+UIChartStyle    MakeChartStyle   (const UITheme& t, const UIStyle& s);
+UIImageStyle    MakeImageStyle   (const UITheme& t, const UIStyle& s);
+
+// Resolved styles keyed by (theme generation, style generation, style type).
+// Lookups are a short scan; a miss rebuilds the struct once. UI thread only.
+template<class S, S (*Make)(const UITheme&, const UIStyle&)>
+struct UIStyleMakerFn {
+    static S make(const UITheme& t, const UIStyle& s) { return Make(t, s); }
+};
+template<class S> struct UIStyleMaker;
+template<> struct UIStyleMaker<UITextFieldStyle> : UIStyleMakerFn<UITextFieldStyle, MakeTextFieldStyle> {};
+template<> struct UIStyleMaker<UITextAreaStyle>  : UIStyleMakerFn<UITextAreaStyle,  MakeTextAreaStyle>  {};
+template<> struct UIStyleMaker<UIButtonStyle>    : UIStyleMakerFn<UIButtonStyle,    MakeButtonStyle>    {};
+template<> struct UIStyleMaker<UICheckboxStyle>  : UIStyleMakerFn<UICheckboxStyle,  MakeCheckboxStyle>  {};
+template<> struct UIStyleMaker<UIGroupBoxStyle>  : UIStyleMakerFn<UIGroupBoxStyle,  MakeGroupBoxStyle>  {};
+template<> struct UIStyleMaker<UIRadioStyle>     : UIStyleMakerFn<UIRadioStyle,     MakeRadioStyle>     {};
+template<> struct UIStyleMaker<UIComboBoxStyle>  : UIStyleMakerFn<UIComboBoxStyle,  MakeComboBoxStyle>  {};
+template<> struct UIStyleMaker<UISpinnerStyle>   : UIStyleMakerFn<UISpinnerStyle,   MakeSpinnerStyle>   {};
+template<> struct UIStyleMaker<UISliderStyle>    : UIStyleMakerFn<UISliderStyle,    MakeSliderStyle>    {};
+template<> struct UIStyleMaker<UILabelStyle>     : UIStyleMakerFn<UILabelStyle,     MakeLabelStyle>     {};
+template<> struct UIStyleMaker<PopupStyle>       : UIStyleMakerFn<PopupStyle,       MakePopupStyle>     {};
+template<> struct UIStyleMaker<UIProgressStyle>  : UIStyleMakerFn<UIProgressStyle,  MakeProgressStyle>  {};
+template<> struct UIStyleMaker<UIListBoxStyle>   : UIStyleMakerFn<UIListBoxStyle,   MakeListBoxStyle>   {};
+template<> struct UIStyleMaker<UITableStyle>     : UIStyleMakerFn<UITableStyle,     MakeTableStyle>     {};
+template<> struct UIStyleMaker<UIChartStyle>     : UIStyleMakerFn<UIChartStyle,     MakeChartStyle>     {};
+template<> struct UIStyleMaker<UIImageStyle>     : UIStyleMakerFn<UIImageStyle,     MakeImageStyle>     {};
+
+template<class S>
+class UIStyleCache {
+public:
+    // Returns a copy: a later miss may overwrite the entry.
+    static S get(const UITheme& t, Uint64 themeGen, const UIStyle& s, Uint64 styleGen) {
+        for (const Entry& e : entries_)
+            if (e.valid && e.themeGen == themeGen && e.styleGen == styleGen) return e.style;
+        Entry& e = entries_[next_];
+        next_ = (next_ + 1) % CAPACITY;
+        e.themeGen = themeGen;
+        e.styleGen = styleGen;
+        e.valid = true;
+        e.style = UIStyleMaker<S>::make(t, s);
+        return e.style;
+    }
+
+private:
+    static constexpr int CAPACITY = 8;
+    struct Entry {
+        Uint64 themeGen = 0;
+        Uint64 styleGen = 0;
+        bool valid = false;
+        S style{};
+    };
+    static inline Entry entries_[CAPACITY];
+    static inline int next_ = 0;
+};
 
 UITextFieldStyle MakeTextFieldStyle(const UITheme& t);
 UITextAreaStyle  MakeTextAreaStyle (const UITheme& t);
@@ -164,3 +281,7 @@ UIComboBoxStyle  MakeComboBoxStyle (const UITheme& t);
 UISpinnerStyle   MakeSpinnerStyle  (const UITheme& t);
 PopupStyle       MakePopupStyle    (const UITheme& th);
 UIProgressStyle MakeProgressStyle(const UITheme& t);
+UIListBoxStyle  MakeListBoxStyle (const UITheme& t);
+UITableStyle    MakeTableStyle   (const UITheme& t);
+UIChartStyle    MakeChartStyle   (const UITheme& t);
+UIImageStyle    MakeImageStyle   (const UITheme& t);
@@ -0,0 +1,232 @@
+#include "UISyntax.hpp"
+#include <algorithm>
+#include <cctype>
+#include <initializer_list>
+
+namespace {
+
+bool isIdentStart(char c) { return std::isalpha((unsigned char)c) || c == '_'; }
+bool isIdent(char c)      { return std::isalnum((unsigned char)c) || c == '_'; }
+bool isSpace(char c)      { return c == ' ' || c == '\t' || c == '\r'; }
+
+void emit(std::vector<UISyntax::Run>& out, size_t start, size_t end, UISyntax::Token t) {
+    if (end <= start || t == UISyntax::Plain) return;
+    if (!out.empty() && out.back().token == t && out.back().start + out.back().len == start) {
+        out.back().len += Uint32(end - start);
+        return;
+    }
+    out.push_back({ Uint32(start), Uint32(end - start), t });
+}
+
+bool isWordIn(std::string_view w, std::initializer_list<std::string_view> words) {
+    return std::find(words.begin(), words.end(), w) != words.end();
+}
+
+// Decimal or hex literal with optional fraction and exponent.
+size_t scanNumber(std::string_view s, size_t i) {
+    if (s[i] == '-' || s[i] == '+') ++i;
+    if (i + 1 < s.size() && s[i] == '0' && (s[i + 1] == 'x' || s[i + 1] == 'X')) {
+        i += 2;
+        while (i < s.size() && (std::isxdigit((unsigned char)s[i]) || s[i] == '.')) ++i;
+        return i;
+    }
+    while (i < s.size() && (std::isdigit((unsigned char)s[i]) || s[i] == '.')) ++i;
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+        ++i;
+        if (i < s.size() && (s[i] == '+' || s[i] == '-')) ++i;
+        while (i < s.size() && std::isdigit((unsigned char)s[i])) ++i;
+    }
+    return i;
+}
+
+// Closing quote included; an unterminated string runs to the end of the line.
+size_t scanQuoted(std::string_view s, size_t i) {
+    const char q = s[i++];
+    while (i < s.size()) {
+        if (s[i] == '\\') { i += 2; continue; }
+        if (s[i++] == q) break;
+    }
+    return std::min(i, s.size());
+}
+
+bool startsNumber(std::string_view s, size_t i) {
+    if (std::isdigit((unsigned char)s[i])) return true;
+    return (s[i] == '-' || s[i] == '.') && i + 1 < s.size() && std::isdigit((unsigned char)s[i + 1]);
+}
+
+class JsonSyntax : public UISyntax {
+public:
+    State tokenizeLine(std::string_view s, State, std::vector<Run>& out) const override {
+        size_t i = 0;
+        while (i < s.size()) {
+            const char c = s[i];
+            if (isSpace(c)) { ++i; continue; }
+            if (c == '"') {
+                const size_t end = scanQuoted(s, i);
+                size_t j = end;
+                while (j < s.size() && isSpace(s[j])) ++j;
+                emit(out, i, end, j < s.size() && s[j] == ':' ? Key : String);
+                i = end;
+            } else if (startsNumber(s, i)) {
+                const size_t end = scanNumber(s, i);
+                emit(out, i, end, Number);
+                i = end;
+            } else if (isIdentStart(c)) {
+                size_t end = i;
+                while (end < s.size() && isIdent(s[end])) ++end;
+                if (isWordIn(s.substr(i, end - i), { "true", "false", "null" })) emit(out, i, end, Keyword);
+                i = end;
+            } else {
+                if (c == '{' || c == '}' || c == '[' || c == ']' || c == ',' || c == ':') emit(out, i, i + 1, Punct);
+                ++i;
+            }
+        }
+        return 0;
+    }
+};
+
+class IniSyntax : public UISyntax {
+public:
+    State tokenizeLine(std::string_view s, State, std::vector<Run>& out) const override {
+        size_t i = 0;
+        while (i < s.size() && isSpace(s[i])) ++i;
+        if (i == s.size()) return 0;
+        if (s[i] == ';' || s[i] == '#') { emit(out, i, s.size(), Comment); return 0; }
+        if (s[i] == '[') {
+            const size_t close = s.find(']', i);
+            const size_t end = close == std::string_view::npos ? s.size() : close + 1;
+            emit(out, i, end, Section);
+            comment(s, end, out);
+            return 0;
+        }
+
+        const size_t eq = s.find_first_of("=:", i);
+        if (eq == std::string_view::npos) { comment(s, i, out); return 0; }
+        size_t keyEnd = eq;
+        while (keyEnd > i && isSpace(s[keyEnd - 1])) --keyEnd;
+        emit(out, i, keyEnd, Key);
+        emit(out, eq, eq + 1, Punct);
+
+        i = eq + 1;
+        while (i < s.size() && isSpace(s[i])) ++i;
+        if (i == s.size()) return 0;
+        if (s[i] == '"' || s[i] == '\'') {
+            const size_t end = scanQuoted(s, i);
+            emit(out, i, end, String);
+            comment(s, end, out);
+            return 0;
+        }
+        // Bare value up to an inline comment.
+        size_t end = i;
+        while (end < s.size() && !((s[end] == ';' || s[end] == '#') && isSpace(s[end - 1]))) ++end;
+        size_t valEnd = end;
+        while (valEnd > i && isSpace(s[valEnd - 1])) --valEnd;
+        const std::string_view v = s.substr(i, valEnd - i);
+        if (startsNumber(s, i) && scanNumber(s, i) == valEnd) emit(out, i, valEnd, Number);
+        else if (isWordIn(v, { "true", "false", "yes", "no", "on", "off" })) emit(out, i, valEnd, Keyword);
+        emit(out, end, s.size(), Comment);
+        return 0;
+    }
+
+private:
+    static void comment(std::string_view s, size_t i, std::vector<Run>& out) {
+        while (i < s.size() && isSpace(s[i])) ++i;
+        if (i < s.size() && (s[i] == ';' || s[i] == '#')) emit(out, i, s.size(), Comment);
+    }
+};
+
+// State: 0 outside long brackets, else (level << 2) | kind.
+class LuaSyntax : public UISyntax {
+public:
+    State tokenizeLine(std::string_view s, State state, std::vector<Run>& out) const override {
+        size_t i = 0;
+        if (state != 0) {
+            const Token t = (state & 3) == LongComment ? Comment : String;
+            const size_t end = closeLong(s, 0, state >> 2);
+            if (end == std::string_view::npos) { emit(out, 0, s.size(), t); return state; }
+            emit(out, 0, end, t);
+            i = end;
+        }
+
+        while (i < s.size()) {
+            const char c = s[i];
+            if (isSpace(c)) { ++i; continue; }
+
+            if (c == '-' && i + 1 < s.size() && s[i + 1] == '-') {
+                const int level = openLong(s, i + 2);
+                if (level < 0) { emit(out, i, s.size(), Comment); return 0; }
+                const size_t body = i + 2 + size_t(level) + 2;
+                const size_t end = closeLong(s, body, Uint32(level));
+                if (end == std::string_view::npos) { emit(out, i, s.size(), Comment); return (Uint32(level) << 2) | LongComment; }
+                emit(out, i, end, Comment);
+                i = end;
+            } else if (c == '[' && openLong(s, i) >= 0) {
+                const int level = openLong(s, i);
+                const size_t end = closeLong(s, i + size_t(level) + 2, Uint32(level));
+                if (end == std::string_view::npos) { emit(out, i, s.size(), String); return (Uint32(level) << 2) | LongString; }
+                emit(out, i, end, String);
+                i = end;
+            } else if (c == '"' || c == '\'') {
+                const size_t end = scanQuoted(s, i);
+                emit(out, i, end, String);
+                i = end;
+            } else if (std::isdigit((unsigned char)c) ||
+                       (c == '.' && i + 1 < s.size() && std::isdigit((unsigned char)s[i + 1]))) {
+                const size_t end = scanNumber(s, i);
+                emit(out, i, end, Number);
+                i = end;
+            } else if (isIdentStart(c)) {
+                size_t end = i;
+                while (end < s.size() && isIdent(s[end])) ++end;
+                if (isWordIn(s.substr(i, end - i), {
+                        "and", "break", "do", "else", "elseif", "end", "false", "for", "function",
+                        "goto", "if", "in", "local", "nil", "not", "or", "repeat", "return",
+                        "then", "true", "until", "while" }))
+                    emit(out, i, end, Keyword);
+                i = end;
+            } else {
+                if (std::ispunct((unsigned char)c)) emit(out, i, i + 1, Punct);
+                ++i;
+            }
+        }
+        return 0;
+    }
+
+private:
+    enum { LongString = 1, LongComment = 2 };
+
+    // Level of a long bracket opening at i ("[" "="* "["), or -1.
+    static int openLong(std::string_view s, size_t i) {
+        if (i >= s.size() || s[i] != '[') return -1;
+        size_t j = i + 1;
+        while (j < s.size() && s[j] == '=') ++j;
+        return j < s.size() && s[j] == '[' ? int(j - i - 1) : -1;
+    }
+
+    // Offset just past the matching "]" "="*level "]", or npos.
+    static size_t closeLong(std::string_view s, size_t from, Uint32 level) {
+        for (size_t i = s.find(']', from); i != std::string_view::npos; i = s.find(']', i + 1)) {
+            size_t j = i + 1;
+            while (j < s.size() && s[j] == '=') ++j;
+            if (j < s.size() && s[j] == ']' && j - i - 1 == level) return j + 1;
+        }
+        return std::string_view::npos;
+    }
+};
+
+} // namespace
+
+std::shared_ptr<const UISyntax> UISyntax::json() {
+    static const auto s = std::make_shared<const JsonSyntax>();
+    return s;
+}
+
+std::shared_ptr<const UISyntax> UISyntax::ini() {
+    static const auto s = std::make_shared<const IniSyntax>();
+    return s;
+}
+
+std::shared_ptr<const UISyntax> UISyntax::lua() {
+    static const auto s = std::make_shared<const LuaSyntax>();
+    return s;
+}
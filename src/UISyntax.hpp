@@ -0,0 +1,30 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Line-at-a-time tokenizers for UITextArea highlighting. A tokenizer sees
+// one line without its '\n' and the state the previous line ended in, and
+// returns the state it ends in. Nothing else carries between lines, so after
+// an edit the text area re-tokenizes forward only until a line ends in the
+// same state as before.
+class UISyntax {
+public:
+    enum Token : Uint8 { Plain, Keyword, String, Number, Comment, Punct, Key, Section };
+    using State = Uint32;
+
+    // Byte range within the line. Bytes not covered by a run are Plain.
+    struct Run {
+        Uint32 start = 0, len = 0;
+        Token token = Plain;
+    };
+
+    virtual ~UISyntax() = default;
+    virtual State tokenizeLine(std::string_view line, State state, std::vector<Run>& out) const = 0;
+
+    static std::shared_ptr<const UISyntax> json();
+    static std::shared_ptr<const UISyntax> ini();
+    // Long strings and comments ([[ ]], --[==[ ]==]) carry across lines.
+    static std::shared_ptr<const UISyntax> lua();
+};
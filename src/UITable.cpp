@@ -0,0 +1,439 @@
+#include "UITable.hpp"
+#include "UIWorker.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+static constexpr int WHEEL_ROWS    = 3;
+static constexpr int KEY_X_PX      = 40;
+static constexpr int ROW_PAD_Y     = 8;
+static constexpr int SORT_MARK_PX  = 14;
+static constexpr unsigned CANCEL_CHECK = 4096;   // comparisons between staleness checks
+
+static std::string foldCase(std::string s) {
+    for (char& c : s) c = (char)std::tolower((unsigned char)c);
+    return s;
+}
+
+static bool parseNumber(const std::string& s, double& out) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    out = std::strtod(s.c_str(), &end);
+    return end && *end == '\0';
+}
+
+int UITableModel::compare(size_t a, size_t b, int column) const {
+    const std::string sa = cellText(a, column), sb = cellText(b, column);
+    double na, nb;
+    if (parseNumber(sa, na) && parseNumber(sb, nb)) return (na > nb) - (na < nb);
+    return sa.compare(sb);
+}
+
+bool UITableModel::matches(size_t row, const std::string& filter, int columns) const {
+    for (int c = 0; c < columns; ++c)
+        if (foldCase(cellText(row, c)).find(filter) != std::string::npos) return true;
+    return false;
+}
+
+UITable::UITable(int x, int y, int w, int h)
+    : colX(1, 0), pending(std::make_shared<Pending>()) {
+    bounds = { x, y, w, h };
+}
+
+// Queued jobs notice the bump and drop their work.
+UITable::~UITable() {
+    pending->latest.fetch_add(1);
+}
+
+UITable* UITable::setColumns(std::vector<UITableColumn> c) {
+    cols = std::move(c);
+    colX.assign(cols.size() + 1, 0);
+    for (size_t i = 0; i < cols.size(); ++i) colX[i + 1] = colX[i] + std::max(1, cols[i].width);
+    headers.setCapacity(std::max<size_t>(1, cols.size()));
+    headers.invalidateAll();
+    if (sortCol >= (int)cols.size()) sortCol = -1;
+    requestView_();
+    return this;
+}
+
+UITable* UITable::setModel(std::shared_ptr<const UITableModel> m) {
+    model_ = std::move(m);
+    selModel = npos;
+    // The old permutation indexes the old model; show no rows until the
+    // new one is ready rather than reading past the end of the new model.
+    view_ = std::make_shared<const std::vector<Uint32>>();
+    cellsChanged_();
+    requestView_();
+    return this;
+}
+
+void UITable::invalidateRows() {
+    requestView_();
+}
+
+void UITable::sortBy(int column, bool ascending) {
+    if (column >= (int)cols.size()) column = -1;
+    if (column == sortCol && (column < 0 || ascending == sortAsc)) return;
+    sortCol = column;
+    sortAsc = ascending;
+    requestView_();
+}
+
+void UITable::setFilter(std::string text) {
+    text = foldCase(std::move(text));
+    if (text == filterText) return;
+    filterText = std::move(text);
+    requestView_();
+}
+
+// Model order with no filter is the identity and needs no job. Anything
+// else is computed off the UI thread; results that are no longer the
+// latest request are discarded on both sides.
+void UITable::requestView_() {
+    const Uint64 gen = ++requested;
+    pending->latest.store(gen);
+    modelCount = model_ ? model_->rowCount() : 0;
+
+    if (!model_ || (sortCol < 0 && filterText.empty())) {
+        view_.reset();
+        busy = false;
+        cellsChanged_();
+        return;
+    }
+
+    busy = true;
+    markDirty();
+    UIWorker::shared().post([p = pending, m = model_, gen, col = sortCol, asc = sortAsc,
+                             filter = filterText, ncols = (int)cols.size(), count = modelCount] {
+        struct Cancelled {};
+        auto stale = [&] { return p->latest.load(std::memory_order_relaxed) != gen; };
+        if (stale()) return;
+
+        auto res = std::make_shared<Result>();
+        res->gen = gen;
+        res->rows.reserve(count);
+        for (size_t r = 0; r < count; ++r) {
+            if ((r & (CANCEL_CHECK - 1)) == 0 && stale()) return;
+            if (filter.empty() || m->matches(r, filter, ncols)) res->rows.push_back((Uint32)r);
+        }
+        if (col >= 0) {
+            unsigned calls = 0;
+            try {
+                std::stable_sort(res->rows.begin(), res->rows.end(), [&](Uint32 a, Uint32 b) {
+                    if (++calls % CANCEL_CHECK == 0 && stale()) throw Cancelled{};
+                    const int c = m->compare(a, b, col);
+                    return asc ? c < 0 : c > 0;
+                });
+            } catch (const Cancelled&) {
+                return;
+            }
+        }
+        if (stale()) return;
+        std::atomic_store(&p->ready, std::shared_ptr<const Result>(std::move(res)));
+        UIWorker::wakeUI();
+    });
+}
+
+void UITable::takeResult_() {
+    auto res = std::atomic_exchange(&pending->ready, std::shared_ptr<const Result>());
+    if (!res || res->gen != requested) return;
+    view_ = std::shared_ptr<const std::vector<Uint32>>(res, &res->rows);
+    busy = false;
+    cellsChanged_();
+}
+
+void UITable::cellsChanged_() {
+    cells.invalidateAll();
+    selViewValid = false;
+    hoverView = npos;
+    clampScroll_();
+    markDirty();
+}
+
+size_t UITable::selectedView_() const {
+    if (selModel == npos) return npos;
+    if (!selViewValid) {
+        selView = npos;
+        if (!view_) {
+            if (selModel < modelCount) selView = selModel;
+        } else {
+            auto it = std::find(view_->begin(), view_->end(), (Uint32)selModel);
+            if (it != view_->end()) selView = (size_t)(it - view_->begin());
+        }
+        selViewValid = true;
+    }
+    return selView;
+}
+
+void UITable::selectView_(size_t viewRow, bool scrollIntoView) {
+    if (viewRow >= rowCount()) return;
+    if (scrollIntoView) scrollToView_(viewRow);
+    const size_t row = modelRowAt(viewRow);
+    selView = viewRow;
+    selViewValid = true;
+    if (row == selModel) return;
+    selModel = row;
+    markDirty();
+    if (onSelectionChanged) onSelectionChanged(row);
+}
+
+void UITable::selectRow(size_t modelRow, bool scrollIntoView) {
+    if (modelRow == selModel) return;
+    selModel = modelRow;
+    selViewValid = false;
+    if (scrollIntoView && selectedView_() != npos) scrollToView_(selView);
+    markDirty();
+    if (onSelectionChanged) onSelectionChanged(modelRow);
+}
+
+void UITable::scrollToView_(size_t viewRow) {
+    const Layout l = layout_();
+    const double rh = rowHeight();
+    const double top = viewRow * rh;
+    setScroll_(1, bars.reveal(l.scroll, 1, top, rh));
+}
+
+UITable* UITable::setFont(TTF_Font* f) {
+    font = f;
+    clampScroll_();
+    markDirty();
+    return this;
+}
+
+UITable* UITable::setRowHeight(int px) {
+    rowH = std::max(0, px);
+    clampScroll_();
+    markDirty();
+    return this;
+}
+
+TTF_Font* UITable::activeFont_() const {
+    if (font) return font;
+    const UITheme& th = getTheme();
+    return th.font ? th.font : UIConfig::getDefaultFont();
+}
+
+int UITable::rowHeight() const {
+    if (rowH > 0) return rowH;
+    TTF_Font* f = activeFont_();
+    return f ? TTF_FontHeight(f) + ROW_PAD_Y : 24;
+}
+
+UITable::Layout UITable::layout_() const {
+    const int b = resolvedStyle<UITableStyle>().borderPx;
+    const int rh = rowHeight();
+    const SDL_Rect in{ bounds.x + b, bounds.y + b, std::max(0, bounds.w - 2*b), std::max(0, bounds.h - 2*b) };
+    const SDL_Rect body{ in.x, in.y + rh, in.w, std::max(0, in.h - rh) };
+    Layout l;
+    l.scroll = bars.layout(body, (double)colX.back(), (double)rowCount() * rh);
+    l.body = l.scroll.view;
+    l.header = { in.x, in.y, l.body.w, std::min(rh, in.h) };
+    return l;
+}
+
+void UITable::setScroll_(int axis, double v) {
+    if (bars.setOffset(layout_().scroll, axis, v)) markDirty();
+}
+
+void UITable::clampScroll_() {
+    setScroll_(0, bars.offset(0));
+    setScroll_(1, bars.offset(1));
+}
+
+size_t UITable::viewRowAt_(const Layout& l, int x, int y) const {
+    return bars.rowAt(l.scroll, x, y, rowHeight(), rowCount());
+}
+
+int UITable::columnAt_(const Layout& l, int x) const {
+    const int cx = x - l.header.x + (int)bars.offset(0);
+    if (cx < 0 || cx >= colX.back()) return -1;
+    return (int)(std::upper_bound(colX.begin(), colX.end(), cx) - colX.begin()) - 1;
+}
+
+void UITable::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        if (e.user.code == 0xF001) { focused = true;  return; }
+        if (e.user.code == 0xF002) { focused = false; bars.cancelDrag(); return; }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; hoverView = npos; return; }
+    }
+    if (!enabled) return;
+    if (e.type == SDL_MOUSEWHEEL && !hovered) return;
+
+    const Layout l = layout_();
+    if (bars.handleMouse(e, l.scroll, (double)WHEEL_ROWS * rowHeight(),
+                         [this](int axis, double v) { setScroll_(axis, v); })) return;
+
+    if (e.type == SDL_MOUSEMOTION) {
+        hoverView = viewRowAt_(l, e.motion.x, e.motion.y);
+        return;
+    }
+
+    if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+        const SDL_Point p{ e.button.x, e.button.y };
+        if (!SDL_PointInRect(&p, &bounds)) return;
+        if (SDL_PointInRect(&p, &l.header)) {
+            const int c = columnAt_(l, p.x);
+            if (c >= 0 && cols[c].sortable) sortBy(c, c == sortCol ? !sortAsc : true);
+            return;
+        }
+        const size_t v = viewRowAt_(l, p.x, p.y);
+        if (v == npos) return;
+        selectView_(v, true);
+        if (e.button.clicks >= 2 && onActivate) onActivate(selModel);
+        return;
+    }
+
+    if (!focused || e.type != SDL_KEYDOWN) return;
+    const size_t n = rowCount();
+    const size_t cur = selectedView_();
+    const long long page = std::max(1, l.body.h / std::max(1, rowHeight()) - 1);
+    auto move = [&](long long delta) {
+        if (n == 0) return;
+        const long long from = cur == npos ? (delta > 0 ? -1 : (long long)n) : (long long)cur;
+        selectView_((size_t)std::clamp(from + delta, 0LL, (long long)n - 1), true);
+    };
+    switch (e.key.keysym.sym) {
+        case SDLK_UP:       move(-1); break;
+        case SDLK_DOWN:     move(1); break;
+        case SDLK_PAGEUP:   move(-page); break;
+        case SDLK_PAGEDOWN: move(page); break;
+        case SDLK_HOME:     if (n) selectView_(0, true); break;
+        case SDLK_END:      if (n) selectView_(n - 1, true); break;
+        case SDLK_LEFT:     setScroll_(0, bars.offset(0) - KEY_X_PX); break;
+        case SDLK_RIGHT:    setScroll_(0, bars.offset(0) + KEY_X_PX); break;
+        case SDLK_RETURN:
+        case SDLK_KP_ENTER: if (selModel != npos && onActivate) onActivate(selModel); break;
+        default: break;
+    }
+}
+
+void UITable::update(float) {
+    if (model_ && model_->rowCount() != modelCount) requestView_();
+    takeResult_();
+}
+
+static void setClip(SDL_Renderer* r, const SDL_Rect& area, bool hadClip, const SDL_Rect& prev) {
+    SDL_Rect clip = area;
+    if (hadClip && !SDL_IntersectRect(&prev, &area, &clip)) clip = { area.x, area.y, 0, 0 };
+    SDL_RenderSetClipRect(r, &clip);
+}
+
+static int alignX(UITableColumn::Align a, int x, int w, int pad, int textW) {
+    switch (a) {
+        case UITableColumn::Right:  return x + w - pad - textW;
+        case UITableColumn::Center: return x + (w - textW) / 2;
+        default:                    return x + pad;
+    }
+}
+
+void UITable::render(SDL_Renderer* renderer) {
+    if (!visible) return;
+    const auto st = resolvedStyle<UITableStyle>();
+    TTF_Font* f = activeFont_();
+
+    const LookStamp look = lookStamp();
+    if (look != seenLook) {
+        seenLook = look;
+        cells.invalidateAll();
+        headers.invalidateAll();
+    }
+
+    SDL_Color borderNow = focused ? st.borderFocus : (hovered ? st.borderHover : st.border);
+    if (st.borderPx > 0) {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, borderNow);
+        UIHelpers::FillRoundedRect(renderer, bounds.x + st.borderPx, bounds.y + st.borderPx,
+                                   bounds.w - 2*st.borderPx, bounds.h - 2*st.borderPx,
+                                   std::max(0, st.radius - st.borderPx), st.bg);
+    } else {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.bg);
+    }
+
+    const Layout l = layout_();
+    const int rh = std::max(1, rowHeight());
+    const int ncols = (int)cols.size();
+    const int sx = (int)bars.offset(0);
+    const int c0 = std::max(0, (int)(std::upper_bound(colX.begin(), colX.end(), sx) - colX.begin()) - 1);
+
+    SDL_Rect prevClip;
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer);
+    SDL_RenderGetClipRect(renderer, &prevClip);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    // Header
+    setClip(renderer, l.header, hadClip, prevClip);
+    SDL_SetRenderDrawColor(renderer, st.headerBg.r, st.headerBg.g, st.headerBg.b, st.headerBg.a);
+    SDL_RenderFillRect(renderer, &l.header);
+    for (int c = c0; c < ncols && colX[c] - sx < l.header.w; ++c) {
+        const int x = l.header.x + colX[c] - sx, w = colX[c + 1] - colX[c];
+        const bool sorted = (c == sortCol);
+        if (f) {
+            const int maxW = w - 2*st.padX - (sorted ? SORT_MARK_PX : 0);
+            const auto t = headers.get(renderer, f, st.headerFg, (size_t)c, maxW, [&] { return cols[c].title; });
+            if (t.texture) {
+                const SDL_Rect src{ 0, 0, t.w, t.h };
+                const SDL_Rect dst{ alignX(cols[c].align, x, w - (sorted ? SORT_MARK_PX : 0), st.padX, t.w),
+                                    l.header.y + (l.header.h - t.h) / 2, t.w, t.h };
+                SDL_RenderCopy(renderer, t.texture, &src, &dst);
+            }
+        }
+        if (sorted) {
+            // Dimmed while the new order is still being computed.
+            const SDL_Color mark = UIHelpers::WithAlpha(st.headerFg, busy ? 110 : 255);
+            const float cx = (float)(x + w - st.padX - 4), cy = (float)(l.header.y + l.header.h / 2);
+            if (sortAsc) {
+                UIHelpers::DrawRoundStrokeLine(renderer, cx - 4, cy + 2, cx, cy - 2, 1.5f, mark);
+                UIHelpers::DrawRoundStrokeLine(renderer, cx, cy - 2, cx + 4, cy + 2, 1.5f, mark);
+            } else {
+                UIHelpers::DrawChevronDown(renderer, (int)cx + 4, (int)cy, 8, 4, 1.5f, mark);
+            }
+        }
+        SDL_SetRenderDrawColor(renderer, st.grid.r, st.grid.g, st.grid.b, st.grid.a);
+        SDL_RenderDrawLine(renderer, x + w - 1, l.header.y + 4, x + w - 1, l.header.y + l.header.h - 4);
+    }
+    SDL_SetRenderDrawColor(renderer, st.grid.r, st.grid.g, st.grid.b, st.grid.a);
+    SDL_RenderDrawLine(renderer, l.header.x, l.header.y + l.header.h - 1, l.header.x + l.header.w - 1, l.header.y + l.header.h - 1);
+
+    // Body: only the rows and columns that intersect it.
+    const size_t n = rowCount();
+    if (model_ && n > 0 && ncols > 0 && l.body.w > 0 && l.body.h > 0) {
+        setClip(renderer, l.body, hadClip, prevClip);
+        cells.setCapacity(((size_t)(l.body.h / rh) + 2) * (size_t)ncols);
+        const size_t first = (size_t)(bars.offset(1) / rh);
+        const int y0 = l.body.y - (int)(bars.offset(1) - (double)first * rh);
+        const size_t sel = selectedView_();
+        for (size_t v = first; v < n; ++v) {
+            const int y = y0 + (int)(v - first) * rh;
+            if (y >= l.body.y + l.body.h) break;
+            const size_t row = modelRowAt(v);
+            if (row >= modelCount) continue;   // previous order, model since shrunk
+            const bool isSel = (v == sel);
+            if (isSel || v == hoverView) {
+                const SDL_Color bg = isSel ? st.selectedBg : st.hoverBg;
+                const SDL_Rect band{ l.body.x, y, l.body.w, rh };
+                SDL_SetRenderDrawColor(renderer, bg.r, bg.g, bg.b, bg.a);
+                SDL_RenderFillRect(renderer, &band);
+            }
+            if (!f) continue;
+            SDL_Color fg = isSel ? st.selectedFg : st.fg;
+            if (!enabled) fg.a = 160;
+            for (int c = c0; c < ncols && colX[c] - sx < l.body.w; ++c) {
+                const int x = l.body.x + colX[c] - sx, w = colX[c + 1] - colX[c];
+                const auto t = cells.get(renderer, f, fg, v * (size_t)ncols + (size_t)c, w - 2*st.padX,
+                                         [&] { return model_->cellText(row, c); });
+                if (!t.texture) continue;
+                const SDL_Rect src{ 0, 0, t.w, t.h };
+                const SDL_Rect dst{ alignX(cols[c].align, x, w, st.padX, t.w), y + (rh - t.h) / 2, t.w, t.h };
+                SDL_RenderCopy(renderer, t.texture, &src, &dst);
+            }
+        }
+        SDL_SetRenderDrawColor(renderer, st.grid.r, st.grid.g, st.grid.b, st.grid.a);
+        for (int c = c0; c < ncols && colX[c] - sx < l.body.w; ++c) {
+            const int x = l.body.x + colX[c + 1] - sx - 1;
+            SDL_RenderDrawLine(renderer, x, l.body.y, x, l.body.y + l.body.h - 1);
+        }
+    }
+
+    SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
+    bars.render(renderer, l.scroll, st.scrollTrack, st.scrollThumb);
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UIScrollBars.hpp"
+#include "UITextRowCache.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct UITableColumn {
+    enum Align { Left, Center, Right };
+    std::string title;
+    int   width = 120;
+    Align align = Left;
+    bool  sortable = true;
+};
+
+// Row provider for UITable. Sorting and filtering call the const methods
+// from a worker thread while the UI thread keeps drawing, so concurrent
+// reads must be safe. Change the data by swapping in a new model, or call
+// UITable::invalidateRows() once an in-place change is complete.
+class UITableModel {
+public:
+    virtual ~UITableModel() = default;
+    virtual size_t rowCount() const = 0;
+    virtual std::string cellText(size_t row, int column) const = 0;
+    // strcmp-style. The default compares cell text, numerically when both
+    // cells parse as numbers.
+    virtual int compare(size_t a, size_t b, int column) const;
+    // filter is already lower-cased. The default looks for it in every cell.
+    virtual bool matches(size_t row, const std::string& filter, int columns) const;
+};
+
+// Data grid over a UITableModel. Only the cells inside the viewport are
+// drawn, with their text cached per visible cell. Sorting and filtering
+// build a row permutation on UIWorker; the table keeps showing the previous
+// order until the new one is handed over in update().
+class UITable : public UIElement {
+public:
+    static constexpr size_t npos = (size_t)-1;
+
+    UITable(int x, int y, int w, int h);
+    ~UITable() override;
+
+    UITable* setColumns(std::vector<UITableColumn> cols);
+    const std::vector<UITableColumn>& columns() const { return cols; }
+    UITable* setModel(std::shared_ptr<const UITableModel> m);
+    const std::shared_ptr<const UITableModel>& model() const { return model_; }
+    // Re-runs the current sort and filter against the model.
+    void invalidateRows();
+
+    // column < 0 restores model order.
+    void sortBy(int column, bool ascending = true);
+    int  sortColumn() const { return sortCol; }
+    bool sortAscending() const { return sortAsc; }
+    // Case-insensitive; empty shows every row.
+    void setFilter(std::string text);
+    const std::string& filter() const { return filterText; }
+    // A sort or filter is running; the rows shown are the previous result.
+    bool isBusy() const { return busy; }
+
+    size_t rowCount() const { return view_ ? view_->size() : modelCount; }
+    size_t modelRowAt(size_t viewRow) const { return view_ ? (size_t)(*view_)[viewRow] : viewRow; }
+
+    // Selection follows the model row across re-sorts.
+    size_t selectedRow() const { return selModel; }
+    void selectRow(size_t modelRow, bool scrollIntoView = true);
+    UITable* setOnSelectionChanged(std::function<void(size_t)> cb) { onSelectionChanged = std::move(cb); return this; }
+    UITable* setOnActivate(std::function<void(size_t)> cb) { onActivate = std::move(cb); return this; }
+
+    UITable* setFont(TTF_Font* f);
+    // 0 picks the font height plus padding; also used for the header.
+    UITable* setRowHeight(int px);
+    int rowHeight() const;
+
+    void handleEvent(const SDL_Event& e) override;
+    void update(float dt) override;
+    void render(SDL_Renderer* renderer) override;
+    bool isHovered() const override { return hovered; }
+    bool isFocusable() const override { return true; }
+
+private:
+    struct Result {
+        Uint64 gen = 0;
+        std::vector<Uint32> rows;
+    };
+    // Shared with queued jobs so they outlive the table safely.
+    struct Pending {
+        std::atomic<Uint64> latest{ 0 };
+        std::shared_ptr<const Result> ready;   // std::atomic_load/store only
+    };
+
+    std::vector<UITableColumn> cols;
+    std::vector<int> colX;                     // prefix sums, cols.size() + 1
+    std::shared_ptr<const UITableModel> model_;
+    size_t modelCount = 0;
+
+    std::shared_ptr<const std::vector<Uint32>> view_;   // null: model order
+    std::shared_ptr<Pending> pending;
+    Uint64 requested = 0;
+    bool busy = false;
+    int  sortCol = -1;
+    bool sortAsc = true;
+    std::string filterText;
+
+    size_t selModel = npos;
+    mutable size_t selView = npos;
+    mutable bool selViewValid = true;
+    size_t hoverView = npos;
+
+    TTF_Font* font = nullptr;
+    int rowH = 0;
+    UIScrollBars bars;
+    bool focused = false;
+    bool hovered = false;
+
+    std::function<void(size_t)> onSelectionChanged;
+    std::function<void(size_t)> onActivate;
+
+    UITextRowCache cells;
+    UITextRowCache headers;
+    LookStamp seenLook;
+
+    struct Layout {
+        SDL_Rect header, body;
+        UIScrollBars::Layout scroll;   // scroll.view == body
+    };
+    Layout layout_() const;
+    void setScroll_(int axis, double v);
+    void clampScroll_();
+
+    TTF_Font* activeFont_() const;
+    void requestView_();
+    void takeResult_();
+    size_t selectedView_() const;
+    void selectView_(size_t viewRow, bool scrollIntoView);
+    void scrollToView_(size_t viewRow);
+    size_t viewRowAt_(const Layout& l, int x, int y) const;
+    int columnAt_(const Layout& l, int x) const;
+    void cellsChanged_();
+};
@@ -1,9 +1,21 @@
 #include "UITextArea.hpp"
+#include <cctype>
+#include <cstring>
 
 void UITextArea::clearRedo() { redoStack.clear(); }
 
 static inline bool hasSelRange(const size_t a, const size_t b) { return b > a; }
 
+static constexpr Uint32 BLINK_MS = 500;
+
+static bool typedCharAllowed(InputType t, char c) {
+    switch (t) {
+        case InputType::NUMERIC: return std::isdigit((unsigned char)c) != 0;
+        case InputType::EMAIL:   return std::isalnum((unsigned char)c) || c=='@' || c=='.' || c=='-' || c=='_';
+        default: return true;
+    }
+}
+
 void UITextArea::applyReplaceNoHistory(size_t a, size_t b, std::string_view repl,
                                        size_t newCursor, size_t newSelA, size_t newSelB)
 {
@@ -13,6 +25,8 @@ void UITextArea::applyReplaceNoHistory(size_t a, size_t b, std::string_view repl
     if (b < a) std::swap(a, b);
 
     txt.replace(a, b - a, repl);
+    updateMatchesAfterEdit(a, b, repl.size());
+    updateHighlightAfterEdit(a, b, repl.size());
     cursorPos = std::min(newCursor, txt.size());
 
     if (hasSelRange(newSelA, newSelB)) {
@@ -24,7 +38,7 @@ void UITextArea::applyReplaceNoHistory(size_t a, size_t b, std::string_view repl
 
     preferredXpx = -1; preferredColumn = -1;
     updateCursorPosition(); setIMERectAtCaret();
-    lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+    restartBlink();
 }
 
 void UITextArea::pushEdit(EditRec e, bool tryCoalesce)
@@ -97,6 +111,49 @@ void UITextArea::replaceRange(size_t a, size_t b, std::string_view repl, EditRec
     if (historyEnabled) pushEdit(std::move(e), tryCoalesce);
 }
 
+void UITextArea::insertTyped(std::string_view in)
+{
+    imeText.clear(); imeStart = imeLength = 0; imeActive = false;
+    if (in.empty()) return;
+
+    size_t a = hasSelection() ? selRange().first  : cursorPos;
+    size_t b = hasSelection() ? selRange().second : cursorPos;
+    size_t curLen = linkedText.get().size();
+    size_t maxLen = (maxLength > 0) ? (size_t)maxLength : SIZE_MAX;
+    size_t room   = (curLen - (b - a) < maxLen) ? (maxLen - (curLen - (b - a))) : 0;
+    if (room > 0) replaceRange(a, b, in.substr(0, room), EditRec::Typing, true);
+}
+
+// A burst is filtered per character rather than rejected whole, since it
+// usually spans several keystrokes.
+void UITextArea::handleTextBurst(std::string_view text)
+{
+    if (!focused) return;
+    std::string in;
+    in.reserve(text.size());
+    for (char c : text) if (typedCharAllowed(inputType, c)) in += c;
+    insertTyped(in);
+}
+
+// count auto-repeats of Backspace/Delete as one edit: the selection (if
+// any) plus count - 1 further bytes, or count bytes without a selection.
+void UITextArea::handleKeyRepeat(const SDL_KeyboardEvent& key, int count)
+{
+    if (!focused || count <= 0) return;
+    const size_t len = linkedText.get().size();
+    const bool sel = hasSelection();
+    size_t a = sel ? selRange().first  : cursorPos;
+    size_t b = sel ? selRange().second : cursorPos;
+    const size_t n = size_t(count - (sel ? 1 : 0));
+    if (key.keysym.sym == SDLK_BACKSPACE) {
+        a -= std::min(a, n);
+        if (a < b) replaceRange(a, b, "", EditRec::Backspace, !sel);
+    } else if (key.keysym.sym == SDLK_DELETE) {
+        b = std::min(len, b + n);
+        if (a < b) replaceRange(a, b, "", EditRec::DeleteKey, !sel);
+    }
+}
+
 void UITextArea::undo()
 {
     if (undoStack.empty()) return;
@@ -145,8 +202,6 @@ void UITextArea::handleEvent(const SDL_Event& e) {
         if (selStart > MAX_TEXT_LENGTH) selStart = MAX_TEXT_LENGTH;
         if (selEnd > MAX_TEXT_LENGTH) selEnd = MAX_TEXT_LENGTH;
     }
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
     if (e.type == SDL_USEREVENT) {
         if (e.user.code == 0xF001) { if (!focused) { focused = true; SDL_StartTextInput();preferredXpx = -1; preferredColumn = -1; } return; }
         if (e.user.code == 0xF002) {
@@ -163,6 +218,8 @@ void UITextArea::handleEvent(const SDL_Event& e) {
             preferredXpx = -1; preferredColumn = -1;
             return;
         }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
     }
 
     if (focused && e.type == SDL_TEXTEDITING) {
@@ -171,8 +228,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
         imeLength = e.edit.length;
         imeActive = !imeText.empty();
         setIMERectAtCaret();
-        lastBlinkTime = SDL_GetTicks();
-        cursorVisible = true;
+        restartBlink();
         return;
     }
 
@@ -180,6 +236,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
         SDL_Point p{ e.button.x, e.button.y };
         bool wasFocused = focused;
         focused = SDL_PointInRect(&p, &bounds);
+        dragMouseX = e.button.x; dragMouseY = e.button.y;
 
         if (focused) {
             size_t idx = indexFromMouse(e.button.x, e.button.y);
@@ -205,7 +262,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
                 updateCursorPosition();
                 setIMERectAtCaret();
                 SDL_StartTextInput();
-                lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+                restartBlink();
                 selectingMouse = false;
                 return;
             }
@@ -229,7 +286,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
                 preferredXpx    = -1;
                 updateCursorPosition(); setIMERectAtCaret();
                 SDL_StartTextInput();
-                lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+                restartBlink();
                 selectingMouse = false;
                 return;
             }
@@ -250,7 +307,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
             }
             updateCursorPosition(); setIMERectAtCaret();
             SDL_StartTextInput();
-            lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+            restartBlink();
             selectingMouse = true;
             SDL_CaptureMouse(SDL_TRUE);
         } else if (wasFocused && !focused) {
@@ -290,6 +347,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
     }
 
     if (e.type == SDL_MOUSEMOTION) {
+        dragMouseX = e.motion.x; dragMouseY = e.motion.y;
         if (selectingMouse && !(e.motion.state & SDL_BUTTON_LMASK)) {
             SDL_CaptureMouse(SDL_FALSE);
             selectingMouse = false;
@@ -300,7 +358,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
         }
         if (scrollbarDragging) {
             int dy = e.motion.y - scrollbarDragStartY;
-            const auto st = MakeTextAreaStyle(th, ds);
+            const auto st = resolvedStyle<UITextAreaStyle>();
             const int viewH = std::max(0, bounds.h - 2*st.borderPx - 2*paddingPx);
             const float maxScroll = std::max(0.0f, contentHeight - float(viewH));
             scrollOffsetY = scrollbarThumbStartOffset + dy * (maxScroll) / float(viewH);
@@ -309,7 +367,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
         }
 
         if (selectingMouse && focused) {
-            const auto st = MakeTextAreaStyle(th, ds);
+            const auto st = resolvedStyle<UITextAreaStyle>();
             const int borderPx = st.borderPx;
             const int innerY0  = bounds.y + borderPx + paddingPx;
             const int innerH   = std::max(0, bounds.h - 2*borderPx - 2*paddingPx);
@@ -324,12 +382,11 @@ void UITextArea::handleEvent(const SDL_Event& e) {
                 preferredXpx    = -1;
                 updateCursorPosition();
                 setIMERectAtCaret();
-                lastBlinkTime = SDL_GetTicks();
-                cursorVisible = true;
+                restartBlink();
             }
             return;
         }
-        const auto st = MakeTextAreaStyle(th, ds);
+        const auto st = resolvedStyle<UITextAreaStyle>();
         const int viewH = std::max(0, bounds.h - 2*st.borderPx - 2*paddingPx);
         if (contentHeight > bounds.h) {
             SDL_Point p{ e.motion.x, e.motion.y };
@@ -347,11 +404,10 @@ void UITextArea::handleEvent(const SDL_Event& e) {
     }
 
     if (e.type == SDL_MOUSEWHEEL) {
-        int mx, my; SDL_GetMouseState(&mx, &my);
-        if (mx >= bounds.x && mx <= bounds.x + bounds.w && my >= bounds.y && my <= bounds.y + bounds.h) {
+        if (hovered) {
             int lh = TTF_FontHeight(font ? font : UIConfig::getDefaultFont());
             scrollOffsetY -= e.wheel.y * lh;
-            const auto st = MakeTextAreaStyle(th, ds);
+            const auto st = resolvedStyle<UITextAreaStyle>();
             const int viewH = std::max(0, bounds.h - 2*st.borderPx - 2*paddingPx);
             scrollOffsetY = std::clamp(scrollOffsetY, 0.0f, std::max(0.0f, contentHeight - float(viewH)));
             if (focused) setIMERectAtCaret();
@@ -360,26 +416,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
     }
 
     if (focused && e.type == SDL_TEXTINPUT) {
-        imeText.clear(); imeStart = imeLength = 0; imeActive = false;
-
-        std::string in = e.text.text;
-        bool valid = true;
-        switch (inputType) {
-            case InputType::NUMERIC: valid = std::all_of(in.begin(), in.end(), ::isdigit); break;
-            case InputType::EMAIL:   valid = std::all_of(in.begin(), in.end(), [](char c){ return std::isalnum(c) || c=='@' || c=='.' || c=='-' || c=='_'; }); break;
-            default: break;
-        }
-        if (valid && !in.empty()) {
-            size_t a = hasSelection() ? selRange().first  : cursorPos;
-            size_t b = hasSelection() ? selRange().second : cursorPos;
-            size_t curLen = linkedText.get().size();
-            size_t maxLen = (maxLength > 0) ? (size_t)maxLength : SIZE_MAX;
-            size_t room   = (curLen - (b - a) < maxLen) ? (maxLen - (curLen - (b - a))) : 0;
-            if (room > 0) {
-                if (in.size() > room) in.resize(room);
-                replaceRange(a, b, in, EditRec::Typing, true);
-            }
-        }
+        handleTextBurst(e.text.text);
         return;
     }
 
@@ -402,7 +439,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
             selectAll();
             preferredColumn = -1; preferredXpx = -1;
             updateCursorPosition(); setIMERectAtCaret();
-            lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+            restartBlink();
             return;
         }
         if (ctrl && e.key.keysym.sym == SDLK_c) {
@@ -430,6 +467,11 @@ void UITextArea::handleEvent(const SDL_Event& e) {
             return;
         }
 
+        if (e.key.keysym.sym == SDLK_F3) {
+            if (shift) findPrevious(); else findNext();
+            return;
+        }
+
         if (e.key.keysym.sym == SDLK_RETURN || e.key.keysym.sym == SDLK_KP_ENTER) {
             size_t a = hasSelection() ? selRange().first  : cursorPos;
             size_t b = hasSelection() ? selRange().second : cursorPos;
@@ -475,7 +517,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
             }
             
             preferredColumn = -1; preferredXpx = -1;
-            lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+            restartBlink();
             updateCursorPosition(); setIMERectAtCaret();
             return;
         }
@@ -539,7 +581,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
                 selectAnchor = cursorPos;
             }
 
-            lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+            restartBlink();
             updateCursorPosition(); setIMERectAtCaret();
 
             i = std::min(cursorPos, N);
@@ -562,7 +604,7 @@ void UITextArea::handleEvent(const SDL_Event& e) {
             return;
         }
 
-        lastBlinkTime = SDL_GetTicks(); cursorVisible = true;
+        restartBlink();
         updateCursorPosition(); setIMERectAtCaret();
         return;
     }
@@ -570,49 +612,34 @@ void UITextArea::handleEvent(const SDL_Event& e) {
 }
 
 void UITextArea::update(float) {
-    int mx, my; SDL_GetMouseState(&mx, &my);
-    SDL_Point pt{ mx, my };
-    hovered = SDL_PointInRect(&pt, &bounds);
     if (linkedText.get().length() > size_t(maxLength)) {
         linkedText.get().resize(maxLength);
         if (cursorPos > static_cast<size_t>(maxLength)) cursorPos = static_cast<size_t>(maxLength);
     }
+    // The bound string was changed from outside the widget.
+    if (!findQuery.empty() && linkedText.get().size() != findDocSize) rescanMatches();
+    if (syntax && linkedText.get().size() != hlDocSize) rehighlightAll();
     if (focused) {
-        Uint32 now = SDL_GetTicks();
-        if (now - lastBlinkTime >= 500) {
-            cursorVisible = !cursorVisible;
-            lastBlinkTime = now;
-        }
+        if (timers && !timers->isActive(blinkTimer)) restartBlink();
     } else {
+        stopBlink();
         cursorVisible = false;
-        lastBlinkTime = SDL_GetTicks();
         preferredXpx    = -1;
         preferredColumn = -1;
     }
     TTF_Font* fnt = font ? font : UIConfig::getDefaultFont();
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeTextAreaStyle(th, ds);
+    const auto st = resolvedStyle<UITextAreaStyle>();
     const int innerW = std::max(0, bounds.w - 2*st.borderPx - 2*paddingPx);
 
-    rebuildLayout(fnt, innerW);
+    // Also catches the bound string changing from outside the widget.
+    if (rebuildLayout(fnt, innerW)) markDirty();
     const int viewH = std::max(0, bounds.h - 2*st.borderPx - 2*paddingPx);
     contentHeight = float(std::max<size_t>(1, lines.size())) * float(TTF_FontHeight(fnt));
     scrollOffsetY = std::clamp(scrollOffsetY, 0.0f, std::max(0.0f, contentHeight - float(viewH)));
     if (focused) setIMERectAtCaret();
 
-    {
-        Uint32 btns = SDL_GetMouseState(nullptr, nullptr);
-        if (selectingMouse && !(btns & SDL_BUTTON(SDL_BUTTON_LEFT))) {
-            SDL_CaptureMouse(SDL_FALSE);
-            selectingMouse = false;
-        }
-        if (scrollbarDragging && !(btns & SDL_BUTTON(SDL_BUTTON_LEFT))) {
-            scrollbarDragging = false;
-        }
-    }
-
     if (focused && selectingMouse) {
+        const int mx = dragMouseX, my = dragMouseY;
         const int borderPx = st.borderPx;
         const int innerY0  = bounds.y + borderPx + paddingPx;
         const int innerH   = std::max(0, bounds.h - 2*borderPx - 2*paddingPx);
@@ -636,12 +663,22 @@ void UITextArea::update(float) {
         preferredXpx    = -1;
         updateCursorPosition();
         setIMERectAtCaret();
-        lastBlinkTime = SDL_GetTicks();
-        cursorVisible = true;
+        restartBlink();
     }
 }
 
+void UITextArea::restartBlink() {
+    cursorVisible = true;
+    if (!timers) return;
+    timers->cancel(blinkTimer);
+    blinkTimer = timers->every(this, BLINK_MS, [this]{ cursorVisible = !cursorVisible; markDirty(); });
+}
 
+void UITextArea::stopBlink() {
+    if (blinkTimer == UITimerWheel::InvalidTimer) return;
+    if (timers) timers->cancel(blinkTimer);
+    blinkTimer = UITimerWheel::InvalidTimer;
+}
 
 bool UITextArea::isHovered() const {
     return hovered;
@@ -771,8 +808,10 @@ void UITextArea::render(SDL_Renderer* renderer) {
     if (!fnt) return;
     
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeTextAreaStyle(th, ds);
+    const auto st = resolvedStyle<UITextAreaStyle>();
+
+    const LookStamp look = lookStamp();
+    if (look != seenLook) { seenLook = look; lineCache.invalidateAll(); }
 
     SDL_Rect dst = bounds;
     const int effRadius   = st.radius;
@@ -844,10 +883,37 @@ void UITextArea::render(SDL_Renderer* renderer) {
         selectionRects.reserve(lines.size());
     }
 
+    std::vector<SDL_Rect> matchRects;
+    const size_t findLen = findQuery.size();
+    const size_t layoutN = mapOrigToNoNL.size() - 1;
+    auto noNL = [&](size_t pos) { return mapOrigToNoNL[std::min(pos, layoutN)]; };
+    size_t hit = (size_t)-1;
+
+    const bool highlight = syntax && !hlLines.empty() && hlDocSize == N;
+    if (highlight) lineCache.setCapacity((size_t)(viewH / std::max(1, lh)) + 2);
+
     int y = innerY - (int)scrollOffsetY;
     for (size_t li = 0; li < lines.size(); ++li) {
         const auto& line = lines[li];
 
+        if (!findHits.empty() && y + lh > clip.y && y < clip.y + clip.h) {
+            const size_t L0 = lineStart[li], L1 = L0 + line.size();
+            if (hit == (size_t)-1) {
+                hit = size_t(std::partition_point(findHits.begin(), findHits.end(),
+                                                  [&](size_t s) { return noNL(s + findLen) <= L0; }) - findHits.begin());
+            }
+            while (hit < findHits.size() && noNL(findHits[hit] + findLen) <= L0) ++hit;
+            for (size_t j = hit; j < findHits.size(); ++j) {
+                const size_t mA = noNL(findHits[j]);
+                if (mA >= L1) break;
+                const size_t Lg = std::max(mA, L0), Rg = std::min(noNL(findHits[j] + findLen), L1);
+                if (Rg > Lg) {
+                    matchRects.push_back({ innerX + prefixX[li][Lg - L0], y,
+                                           prefixX[li][Rg - L0] - prefixX[li][Lg - L0], lh });
+                }
+            }
+        }
+
         if (drawSelection) {
             size_t Lg = std::max(selA, lineStart[li]);
             size_t Rg = std::min(selB, lineStart[li] + line.size());
@@ -880,7 +946,20 @@ void UITextArea::render(SDL_Renderer* renderer) {
             }
         }
 
-        if (!line.empty()) {
+        const bool onScreen = y + lh > clip.y && y < clip.y + clip.h;
+        if (!line.empty() && onScreen && highlight) {
+            const size_t origA = mapNoNLToOrig[lineStart[li]];
+            const size_t src = size_t(std::upper_bound(hlStart.begin(), hlStart.end(), origA) - hlStart.begin()) - 1;
+            const size_t col0 = origA - hlStart[src];
+            const Uint64 stamp = (hlLines[src].stamp * 0x9E3779B97F4A7C15ull) ^ (Uint64(col0) << 24) ^ line.size();
+            const auto t = lineCache.get(renderer, fnt, li, stamp, clip.w,
+                                         [&] { return drawHighlighted(fnt, st, li, src, col0); });
+            if (t.texture) {
+                const SDL_Rect srcR{ 0, 0, t.w, t.h };
+                const SDL_Rect tr{ innerX, y, t.w, t.h };
+                SDL_RenderCopy(renderer, t.texture, &srcR, &tr);
+            }
+        } else if (!line.empty() && onScreen) {
             auto surface = UIHelpers::MakeSurface(
                 TTF_RenderUTF8_Blended(fnt, line.c_str(), st.fg)
             );
@@ -897,6 +976,11 @@ void UITextArea::render(SDL_Renderer* renderer) {
         y += lh;
     }
 
+    if (!matchRects.empty()) {
+        SDL_SetRenderDrawColor(renderer, st.matchBg.r, st.matchBg.g, st.matchBg.b, st.matchBg.a);
+        SDL_RenderFillRects(renderer, matchRects.data(), static_cast<int>(matchRects.size()));
+    }
+
     if (!selectionRects.empty()) {
         SDL_SetRenderDrawColor(renderer, th.selectionBg.r, th.selectionBg.g, 
                                th.selectionBg.b, th.selectionBg.a);
@@ -978,9 +1062,7 @@ void UITextArea::updateCursorPosition() {
     TTF_Font* fnt = font ? font : UIConfig::getDefaultFont();
     if (!fnt) return;
 
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeTextAreaStyle(th, ds);
+    const auto st = resolvedStyle<UITextAreaStyle>();
     const int borderPx = st.borderPx;
     const int innerX0  = bounds.x + borderPx + paddingPx;
     const int innerY0  = bounds.y + borderPx + paddingPx;
@@ -1068,9 +1150,8 @@ SDL_Rect UITextArea::getScrollbarRect() const {
 
 void UITextArea::renderScrollbar(SDL_Renderer* renderer) {
     const UITheme& theme = getTheme();
-    const UIStyle& ds = getStyle();
     SDL_Rect sb = getScrollbarRect();
-    const auto st = MakeTextAreaStyle(theme, ds);
+    const auto st = resolvedStyle<UITextAreaStyle>();
     const int viewH = std::max(0, bounds.h - 2*st.borderPx - 2*paddingPx);
     float vr = float(viewH)/contentHeight;
     int th = std::max(int(viewH*vr), 20);
@@ -1095,9 +1176,7 @@ bool UITextArea::isScrollbarDragging() const {
 size_t UITextArea::indexFromMouse(int mx, int my) const {
     TTF_Font* fnt = font ? font : UIConfig::getDefaultFont();
     if (!fnt) return cursorPos;
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeTextAreaStyle(th, ds);
+    const auto st = resolvedStyle<UITextAreaStyle>();
     const int borderPx = st.borderPx;
     const int innerX0  = bounds.x + borderPx + paddingPx;
     const int innerY0  = bounds.y + borderPx + paddingPx;
@@ -1149,9 +1228,7 @@ size_t UITextArea::indexFromMouse(int mx, int my) const {
 void UITextArea::setIMERectAtCaret() {
     TTF_Font* fnt = font ? font : UIConfig::getDefaultFont();
     if (!fnt) return;
-    const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeTextAreaStyle(th, ds);
+    const auto st = resolvedStyle<UITextAreaStyle>();
     const int borderPx = st.borderPx;
     const int innerX0  = bounds.x + borderPx + paddingPx;
     const int innerY0  = bounds.y + borderPx + paddingPx;
@@ -1180,18 +1257,18 @@ void UITextArea::setSelection(size_t a, size_t b) {
     }
 }
 
-void UITextArea::rebuildLayout(TTF_Font* fnt, int maxWidthPx) const {
+bool UITextArea::rebuildLayout(TTF_Font* fnt, int maxWidthPx) const {
     const std::string& full = linkedText.get();
     
     if (full.size() > MAX_TEXT_LENGTH) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, 
                     "Text exceeds maximum length (%zu > %zu), truncating layout",
                     full.size(), MAX_TEXT_LENGTH);
-        if (!lines.empty()) return;
+        if (!lines.empty()) return false;
     }
     
     if (cacheFont == fnt && cacheWidthPx == maxWidthPx && cacheText == full && !lines.empty())
-        return;
+        return false;
 
     cacheFont = fnt; 
     cacheWidthPx = maxWidthPx; 
@@ -1386,6 +1463,7 @@ void UITextArea::rebuildLayout(TTF_Font* fnt, int maxWidthPx) const {
     } else {
         mapNoNLToOrig[noNLIndex] = full.size();
     }
+    return true;
 }
 
 
@@ -1417,4 +1495,297 @@ int UITextArea::xAtIndex(size_t pos) const {
     size_t st = lineStart[li];
     size_t col = (pos > st) ? std::min(pos - st, lines[li].size()) : 0;
     return prefixX[li][col];
-}
\ No newline at end of file
+}
+
+// First match starting in [from, limit). memchr finds candidates for the
+// first byte (both cases when folding), the rest is compared in place.
+size_t UITextArea::scanMatch(size_t from, size_t limit) const {
+    const std::string& txt = linkedText.get();
+    const size_t n = findQuery.size();
+    if (n == 0 || txt.size() < n) return std::string::npos;
+    limit = std::min(limit, txt.size() - n + 1);
+    if (from >= limit) return std::string::npos;
+
+    const char* hay = txt.data();
+    const char* end = hay + limit;
+    const unsigned char c0 = (unsigned char)findQuery[0];
+    const int lo = c0, up = findMatchCase ? c0 : std::toupper(c0);
+    auto next = [&](int c, const char* p) -> const char* {
+        if (p >= end) return end;
+        const void* q = std::memchr(p, c, size_t(end - p));
+        return q ? static_cast<const char*>(q) : end;
+    };
+    auto rest = [&](const char* p) {
+        if (findMatchCase) return std::memcmp(p + 1, findQuery.data() + 1, n - 1) == 0;
+        for (size_t i = 1; i < n; ++i)
+            if (std::tolower((unsigned char)p[i]) != (unsigned char)findQuery[i]) return false;
+        return true;
+    };
+
+    const char* a = next(lo, hay + from);
+    const char* b = up != lo ? next(up, hay + from) : end;
+    for (;;) {
+        const char* p = std::min(a, b);
+        if (p >= end) return std::string::npos;
+        if (rest(p)) return size_t(p - hay);
+        if (p == a) a = next(lo, p + 1);
+        if (p == b) b = next(up, p + 1);
+    }
+}
+
+void UITextArea::rescanMatches() {
+    findHits.clear();
+    findDocSize = linkedText.get().size();
+    for (size_t p = scanMatch(0, findDocSize); p != std::string::npos; p = scanMatch(p + findQuery.size(), findDocSize))
+        findHits.push_back(p);
+    markDirty();
+}
+
+// [a, oldEnd) became newLen bytes. Matches ending before the edit stand;
+// the search restarts just before it and stops as soon as it lines up with
+// a match from before the edit, whose tail is then shifted into place.
+void UITextArea::updateMatchesAfterEdit(size_t a, size_t oldEnd, size_t newLen) {
+    if (findQuery.empty()) return;
+    const std::string& txt = linkedText.get();
+    if (txt.size() - newLen + (oldEnd - a) != findDocSize) { rescanMatches(); return; }
+
+    const size_t n = findQuery.size();
+    const size_t newEnd = a + newLen;
+    const ptrdiff_t delta = (ptrdiff_t)newLen - (ptrdiff_t)(oldEnd - a);
+
+    std::vector<size_t> old;
+    old.swap(findHits);
+    auto it = std::partition_point(old.begin(), old.end(), [&](size_t s) { return s + n <= a; });
+    findHits.assign(old.begin(), it);
+    findHits.reserve(old.size() + 8);
+
+    size_t q = findHits.empty() ? 0 : findHits.back() + n;
+    if (a + 1 > n) q = std::max(q, a + 1 - n);
+    for (;;) {
+        if (q >= newEnd) {
+            const size_t qOld = size_t((ptrdiff_t)q - delta);
+            it = std::lower_bound(it, old.end(), qOld);
+            if (it == old.begin() || *(it - 1) + n <= qOld) {
+                for (; it != old.end(); ++it) findHits.push_back(size_t((ptrdiff_t)*it + delta));
+                break;
+            }
+        }
+        const size_t p = scanMatch(q, q < newEnd ? newEnd : txt.size());
+        if (p == std::string::npos) {
+            if (q < newEnd) { q = newEnd; continue; }
+            break;
+        }
+        findHits.push_back(p);
+        q = p + n;
+    }
+    findDocSize = txt.size();
+    markDirty();
+}
+
+void UITextArea::setFindQuery(const std::string& query, bool matchCase) {
+    findMatchCase = matchCase;
+    findQuery = query;
+    if (!matchCase)
+        for (char& c : findQuery) c = (char)std::tolower((unsigned char)c);
+    if (findQuery.empty()) { clearFind(); return; }
+    rescanMatches();
+}
+
+void UITextArea::clearFind() {
+    findQuery.clear();
+    findHits.clear();
+    findDocSize = 0;
+    markDirty();
+}
+
+void UITextArea::selectMatch(size_t i) {
+    const size_t s = findHits[i];
+    setSelection(s, s + findQuery.size());
+    selectAnchor = s;
+    cursorPos = s + findQuery.size();
+    preferredColumn = -1; preferredXpx = -1;
+    updateCursorPosition(); setIMERectAtCaret();
+    restartBlink();
+    markDirty();
+}
+
+bool UITextArea::findNext() {
+    if (findHits.empty()) return false;
+    const size_t from = hasSelection() ? selRange().first + 1 : cursorPos;
+    auto it = std::lower_bound(findHits.begin(), findHits.end(), from);
+    selectMatch(it == findHits.end() ? 0 : size_t(it - findHits.begin()));
+    return true;
+}
+
+bool UITextArea::findPrevious() {
+    if (findHits.empty()) return false;
+    const size_t from = hasSelection() ? selRange().first : cursorPos;
+    auto it = std::lower_bound(findHits.begin(), findHits.end(), from);
+    selectMatch(it == findHits.begin() ? findHits.size() - 1 : size_t(it - findHits.begin()) - 1);
+    return true;
+}
+
+bool UITextArea::replaceCurrent(std::string_view replacement) {
+    if (hasSelection()) {
+        auto [a, b] = selRange();
+        const size_t curLen = linkedText.get().size();
+        const size_t maxLen = (maxLength > 0) ? (size_t)maxLength : SIZE_MAX;
+        if (b - a == findQuery.size() && std::binary_search(findHits.begin(), findHits.end(), a) &&
+            curLen - (b - a) + replacement.size() <= maxLen) {
+            replaceRange(a, b, replacement, EditRec::Replace, false);
+            findNext();
+            return true;
+        }
+    }
+    findNext();
+    return false;
+}
+
+// The span from the first to the last match is rebuilt once and goes in as a
+// single EditRec, so undo restores it in one step and layout runs once.
+size_t UITextArea::replaceAll(std::string_view replacement) {
+    if (findHits.empty()) return 0;
+    const std::string& txt = linkedText.get();
+    const size_t n = findQuery.size(), count = findHits.size();
+    const size_t newSize = txt.size() + count * replacement.size() - count * n;
+    if (maxLength > 0 && newSize > (size_t)maxLength) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "Replace all would exceed maximum length (%zu > %d), skipped", newSize, maxLength);
+        return 0;
+    }
+
+    const size_t first = findHits.front(), last = findHits.back() + n;
+    std::string out;
+    out.reserve(last - first + count * replacement.size() - count * n);
+    size_t at = first;
+    for (size_t s : findHits) {
+        out.append(txt, at, s - at);
+        out.append(replacement);
+        at = s + n;
+    }
+    replaceRange(first, last, out, EditRec::Replace, false);
+    return count;
+}
+
+void UITextArea::setSyntax(std::shared_ptr<const UISyntax> s) {
+    syntax = std::move(s);
+    hlStart.clear();
+    hlLines.clear();
+    hlDocSize = 0;
+    lineCache.invalidateAll();
+    if (syntax) rehighlightAll();
+    markDirty();
+}
+
+UISyntax::State UITextArea::tokenizeSourceLine(size_t i, UISyntax::State in) {
+    const std::string& txt = linkedText.get();
+    const size_t a = hlStart[i];
+    const size_t b = i + 1 < hlStart.size() ? hlStart[i + 1] - 1 : txt.size();
+    HlLine& l = hlLines[i];
+    l.runs.clear();
+    l.endState = syntax->tokenizeLine(std::string_view(txt).substr(a, b - a), in, l.runs);
+    l.stamp = ++hlNextStamp;
+    return l.endState;
+}
+
+void UITextArea::rehighlightAll() {
+    const std::string& txt = linkedText.get();
+    hlStart.assign(1, 0);
+    for (const char* p = txt.data(); (p = static_cast<const char*>(std::memchr(p, '\n', txt.size() - size_t(p - txt.data())))); ++p)
+        hlStart.push_back(size_t(p - txt.data()) + 1);
+    hlLines.resize(hlStart.size());
+    UISyntax::State state = 0;
+    for (size_t i = 0; i < hlLines.size(); ++i) state = tokenizeSourceLine(i, state);
+    hlDocSize = txt.size();
+    markDirty();
+}
+
+// Source lines first..last were replaced. They are tokenized again, then
+// the following lines only until one ends in the state it had before; the
+// rest keep their runs and textures.
+void UITextArea::updateHighlightAfterEdit(size_t a, size_t oldEnd, size_t newLen) {
+    if (!syntax) return;
+    const std::string& txt = linkedText.get();
+    if (hlLines.empty() || txt.size() - newLen + (oldEnd - a) != hlDocSize) { rehighlightAll(); return; }
+
+    const ptrdiff_t delta = (ptrdiff_t)newLen - (ptrdiff_t)(oldEnd - a);
+    const size_t first = size_t(std::upper_bound(hlStart.begin(), hlStart.end(), a) - hlStart.begin()) - 1;
+    const size_t last  = size_t(std::upper_bound(hlStart.begin(), hlStart.end(), oldEnd) - hlStart.begin()) - 1;
+    const UISyntax::State lastEnd = hlLines[last].endState;
+
+    std::vector<size_t> added;
+    for (size_t i = a; i < a + newLen; ++i)
+        if (txt[i] == '\n') added.push_back(i + 1);
+
+    for (size_t i = last + 1; i < hlStart.size(); ++i) hlStart[i] = size_t((ptrdiff_t)hlStart[i] + delta);
+    hlStart.erase(hlStart.begin() + first + 1, hlStart.begin() + last + 1);
+    hlStart.insert(hlStart.begin() + first + 1, added.begin(), added.end());
+    hlLines.erase(hlLines.begin() + first + 1, hlLines.begin() + last + 1);
+    hlLines.insert(hlLines.begin() + first + 1, added.size(), HlLine{});
+
+    const size_t changedEnd = first + added.size();
+    UISyntax::State state = first > 0 ? hlLines[first - 1].endState : 0;
+    for (size_t i = first; i < hlLines.size(); ++i) {
+        const UISyntax::State before = i == changedEnd ? lastEnd : hlLines[i].endState;
+        state = tokenizeSourceLine(i, state);
+        if (i >= changedEnd && state == before) break;
+    }
+    hlDocSize = txt.size();
+}
+
+static SDL_Color tokenColor(const UITextAreaStyle& st, UISyntax::Token t) {
+    switch (t) {
+        case UISyntax::Keyword: return st.synKeyword;
+        case UISyntax::String:  return st.synString;
+        case UISyntax::Number:  return st.synNumber;
+        case UISyntax::Comment: return st.synComment;
+        case UISyntax::Punct:   return st.synPunct;
+        case UISyntax::Key:     return st.synKey;
+        case UISyntax::Section: return st.synSection;
+        default:                return st.fg;
+    }
+}
+
+// Visual line li starts col0 bytes into source line src. Each run is
+// rendered on its own and copied to its laid-out x.
+UIHelpers::UniqueSurface UITextArea::drawHighlighted(TTF_Font* fnt, const UITextAreaStyle& st,
+                                                     size_t li, size_t src, size_t col0) const {
+    const std::string& line = lines[li];
+    const auto& runs = hlLines[src].runs;
+    const size_t end = col0 + line.size();
+
+    struct Piece { int x; UIHelpers::UniqueSurface surf; };
+    std::vector<Piece> pieces;
+    int width = 0, height = TTF_FontHeight(fnt);
+    auto add = [&](size_t a, size_t b, SDL_Color color) {
+        if (b <= a) return;
+        const std::string part = line.substr(a - col0, b - a);
+        if (part.find_first_not_of(" \t") == std::string::npos) return;
+        auto surf = UIHelpers::MakeSurface(TTF_RenderUTF8_Blended(fnt, part.c_str(), color));
+        if (!surf) return;
+        const int x = prefixX[li][a - col0];
+        width = std::max(width, x + surf->w);
+        height = std::max(height, surf->h);
+        pieces.push_back({ x, std::move(surf) });
+    };
+
+    size_t pos = col0;
+    for (const UISyntax::Run& r : runs) {
+        const size_t ra = std::max<size_t>(r.start, pos), rb = std::min<size_t>(r.start + r.len, end);
+        if (rb <= ra) { if (r.start >= end) break; continue; }
+        add(pos, ra, st.fg);
+        add(ra, rb, tokenColor(st, r.token));
+        pos = rb;
+    }
+    add(pos, end, st.fg);
+    if (pieces.empty() || width <= 0) return nullptr;
+
+    auto out = UIHelpers::MakeSurface(SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888));
+    if (!out) return nullptr;
+    for (Piece& p : pieces) {
+        SDL_SetSurfaceBlendMode(p.surf.get(), SDL_BLENDMODE_NONE);
+        SDL_Rect dstR{ p.x, 0, p.surf->w, p.surf->h };
+        SDL_BlitSurface(p.surf.get(), nullptr, out.get(), &dstR);
+    }
+    return out;
+}
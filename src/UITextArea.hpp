@@ -3,6 +3,9 @@
 #include "UICommon.hpp"
 #include "UIHelpers.hpp"
 #include "UIStyles.hpp"
+#include "UISyntax.hpp"
+#include "UITextRowCache.hpp"
+#include <memory>
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -33,6 +36,9 @@ public:
     void update(float dt) override;
     void render(SDL_Renderer* renderer) override;
     bool isHovered() const override;
+    bool acceptsInputBursts() const override { return true; }
+    void handleTextBurst(std::string_view text) override;
+    void handleKeyRepeat(const SDL_KeyboardEvent& key, int count) override;
     int getWordCount() const;
     void setSelection(size_t a, size_t b);
     inline std::pair<size_t,size_t> selRange() const {
@@ -57,9 +63,28 @@ public:
     size_t indexFromMouse(int mx, int my) const;
     void setIMERectAtCaret();
 
+    // Matches are kept up to date as the text is edited; only the region
+    // around an edit is searched again. Case folding is ASCII only.
+    void setFindQuery(const std::string& query, bool matchCase = true);
+    void clearFind();
+    const std::vector<size_t>& findMatches() const { return findHits; }
+    size_t findMatchCount() const { return findHits.size(); }
+    // Select the next/previous match from the caret, wrapping around.
+    bool findNext();
+    bool findPrevious();
+    // Replaces the selection if it is a match, then selects the next one.
+    bool replaceCurrent(std::string_view replacement);
+    // One undo step. Returns the number of matches replaced.
+    size_t replaceAll(std::string_view replacement);
+
+    // Colors the text with the given tokenizer (UISyntax::json() etc.);
+    // nullptr turns highlighting off. Colored lines are cached as textures.
+    void setSyntax(std::shared_ptr<const UISyntax> s);
+
 private:
     std::vector<std::string> wrapTextToLines(const std::string& text, TTF_Font* font, int maxWidth) const ;
-    void rebuildLayout(TTF_Font* fnt, int maxWidthPx) const;
+    // True if the layout was rebuilt (text, font or width changed).
+    bool rebuildLayout(TTF_Font* fnt, int maxWidthPx) const;
     int lineOfIndex(size_t pos) const;
     int xAtIndex(size_t pos) const;
     std::string label;
@@ -69,7 +94,7 @@ private:
     bool hovered = false;
     bool focused = false;
     TTF_Font* font = nullptr;
-    Uint32 lastBlinkTime = 0;
+    UITimerWheel::TimerId blinkTimer = UITimerWheel::InvalidTimer;
     bool cursorVisible = true;
     size_t cursorPos = 0;
     bool scrollbarHovered = false;
@@ -91,6 +116,7 @@ private:
     int imeLength = 0;
     bool imeActive = false;
     bool selectingMouse = false;
+    int dragMouseX = 0, dragMouseY = 0;
     size_t selectAnchor = 0;
     Uint32 lastClickTicks = 0;
     int clickCount = 0;
@@ -132,4 +158,37 @@ private:
                             size_t newCursor, size_t newSelA, size_t newSelB);
     void replaceRange(size_t a, size_t b, std::string_view repl, EditRec::Kind kind,
                     bool tryCoalesce);
+    void restartBlink();
+    void stopBlink();
+    // TEXTINPUT path shared with handleTextBurst; clamps to maxLength.
+    void insertTyped(std::string_view in);
+
+    std::string findQuery;              // lower-cased when !findMatchCase
+    bool findMatchCase = true;
+    std::vector<size_t> findHits;       // sorted, non-overlapping match starts
+    size_t findDocSize = 0;
+
+    size_t scanMatch(size_t from, size_t limit) const;
+    void rescanMatches();
+    void updateMatchesAfterEdit(size_t a, size_t oldEnd, size_t newLen);
+    void selectMatch(size_t i);
+
+    struct HlLine {
+        UISyntax::State endState = 0;
+        std::vector<UISyntax::Run> runs;
+        Uint64 stamp = 0;               // new on every tokenize; keys the line texture
+    };
+    std::shared_ptr<const UISyntax> syntax;
+    std::vector<size_t> hlStart;        // start offset of each source line
+    std::vector<HlLine> hlLines;
+    size_t hlDocSize = 0;
+    Uint64 hlNextStamp = 0;
+    UITextRowCache lineCache;
+    LookStamp seenLook;
+
+    UISyntax::State tokenizeSourceLine(size_t i, UISyntax::State in);
+    void rehighlightAll();
+    void updateHighlightAfterEdit(size_t a, size_t oldEnd, size_t newLen);
+    UIHelpers::UniqueSurface drawHighlighted(TTF_Font* fnt, const UITextAreaStyle& st,
+                                             size_t li, size_t src, size_t col0) const;
 };
@@ -4,6 +4,9 @@ void UITextField::clearRedo() { redoStack.clear(); }
 
 static inline bool hasSelRangeInt(const int a, const int b) { return b > a; }
 
+static constexpr Uint32 BLINK_MS       = 530;
+static constexpr Uint32 TYPING_HOLD_MS = 300;
+
 void UITextField::applyReplaceNoHistory(size_t a, size_t b, std::string_view repl,
                                         size_t newCursor, int newSelA, int newSelB) {
     auto& txt = linkedText.get();
@@ -22,8 +25,7 @@ void UITextField::applyReplaceNoHistory(size_t a, size_t b, std::string_view rep
         clearSelection();
     }
 
-    cursorVisible   = true;
-    lastBlinkTicks  = SDL_GetTicks();
+    restartBlink();
 }
 
 void UITextField::pushEdit(EditRec e, bool tryCoalesce) {
@@ -130,6 +132,29 @@ void UITextField::redo()
     applyReplaceNoHistory(a, b, e.after, e.cursorAfter, e.selAAfter, e.selBAfter);
 }
 
+static bool typedCharAllowed(InputType t, char c) {
+    switch (t) {
+        case InputType::NUMERIC: return std::isdigit((unsigned char)c) != 0;
+        case InputType::EMAIL:   return std::isalnum((unsigned char)c) || c=='@' || c=='.' || c=='-' || c=='_';
+        default: return true;
+    }
+}
+
+static int prevCodepoint(const std::string& s, int i) {
+    if (i <= 0) return 0;
+    i--;
+    while (i > 0 && ((unsigned char)s[i] & 0xC0) == 0x80) i--;
+    return i;
+}
+
+static int nextCodepoint(const std::string& s, int i) {
+    const int n = (int)s.size();
+    if (i >= n) return n;
+    i++;
+    while (i < n && ((unsigned char)s[i] & 0xC0) == 0x80) i++;
+    return i;
+}
+
 static int clampi(int v, int lo, int hi) { return v < lo ? lo : (v > hi ? hi : v); }
 
 static int textWidth(TTF_Font* font, const std::string& s) {
@@ -142,7 +167,6 @@ UITextField::UITextField(const std::string& label, int x, int y, int w, int h, s
     : label(label), linkedText(bind), maxLength(maxLen)
 {
     bounds = { x, y, w, h };
-    lastBlinkTicks = SDL_GetTicks();
     
     if (maxLength <= 0 || maxLength > MAX_TEXTFIELD_LENGTH) {
         maxLength = MAX_TEXTFIELD_LENGTH;
@@ -157,6 +181,7 @@ UITextField::UITextField(const std::string& label, int x, int y, int w, int h, s
 
 UITextField* UITextField::setPlaceholder(const std::string& text) {
     placeholder = text;
+    markDirty();
     return this;
 }
 
@@ -166,12 +191,14 @@ UITextField* UITextField::setFont(TTF_Font* f) {
         cacheFont = nullptr;
         measuredTextCache.clear();
         glyphX.clear();
+        markDirty();
     }
     return this;
 }
 
 UITextField* UITextField::setInputType(InputType type) {
     inputType = type;
+    markDirty();
     return this;
 }
 
@@ -179,6 +206,124 @@ bool UITextField::isHovered() const {
     return hovered;
 }
 
+SDL_Rect UITextField::innerRect() const {
+    if (borderPx <= 0) return bounds;
+    SDL_Rect r{bounds.x + borderPx, bounds.y + borderPx, bounds.w - 2 * borderPx, bounds.h - 2 * borderPx};
+    if (r.w < 0) r.w = 0;
+    if (r.h < 0) r.h = 0;
+    return r;
+}
+
+void UITextField::ensureCaretVisible() {
+    TTF_Font* activeFont = font ? font : UIConfig::getDefaultFont();
+    if (!activeFont) return;
+    const SDL_Rect innerR = innerRect();
+
+    const int pad = 8;
+    int innerW = innerR.w - 2 * pad;
+    if (innerW < 0) innerW = 0;
+
+    rebuildGlyphX(activeFont);
+    const int w = prefixWidth(std::min<size_t>(caret, glyphX.size() ? glyphX.size()-1 : 0));
+
+    const int margin = 2;
+    const int left  = scrollX + margin;
+    const int right = scrollX + innerW - margin;
+
+    if (w < left) {
+        scrollX = std::max(0, w - margin);
+    } else if (w > right) {
+        scrollX = std::max(0, w - innerW + margin);
+    }
+
+    const int contentW = glyphX.empty() ? 0 : glyphX.back();
+    const int maxScroll = std::max(0, contentW - innerW);
+    if (scrollX > maxScroll) scrollX = maxScroll;
+}
+
+void UITextField::updateImeRect() {
+    TTF_Font* activeFont = font ? font : UIConfig::getDefaultFont();
+    if (!activeFont) return;
+    const SDL_Rect innerR = innerRect();
+    const int pad = 8;
+    const int cursorH = TTF_FontHeight(activeFont);
+
+    rebuildGlyphX(activeFont);
+    int wCaret = prefixWidth(std::min<size_t>(caret, glyphX.size() ? glyphX.size()-1 : 0));
+
+    if (!preedit.empty()) {
+        auto isContB = [](unsigned char c){ return (c & 0xC0) == 0x80; };
+        int preByte = 0, cpLeft = std::max(0, preeditCursor);
+        while (preByte < (int)preedit.size() && cpLeft-- > 0) {
+            preByte++;
+            while (preByte < (int)preedit.size() && isContB((unsigned char)preedit[preByte])) preByte++;
+        }
+
+        std::string preSub = (inputType == InputType::PASSWORD)
+            ? std::string((int)std::count_if(preedit.begin(), preedit.begin() + preByte,
+                [&](unsigned char ch){ return !isContB(ch); }), '*')
+            : preedit.substr(0, preByte);
+
+        int wPre = 0, h = 0;
+        if (!preSub.empty()) TTF_SizeUTF8(activeFont, preSub.c_str(), &wPre, &h);
+        wCaret += wPre;
+    }
+
+    SDL_Rect r{ innerR.x + pad + wCaret - scrollX, innerR.y + (innerR.h - cursorH) / 2, 1, cursorH };
+    SDL_SetTextInputRect(&r);
+}
+
+void UITextField::afterEdit() {
+    ensureCaretVisible();
+    updateImeRect();
+    restartBlink();
+}
+
+void UITextField::insertTyped(std::string_view in) {
+    if (in.empty()) return;
+    const auto& cur = linkedText.get();
+    size_t a = hasSelection() ? (size_t)selRange().first  : (size_t)caret;
+    size_t b = hasSelection() ? (size_t)selRange().second : (size_t)caret;
+
+    size_t maxLen = (maxLength > 0) ? (size_t)maxLength : SIZE_MAX;
+    size_t room   = (cur.size() - (b - a) < maxLen) ? (maxLen - (cur.size() - (b - a))) : 0;
+    if (room > 0) {
+        replaceRange(a, b, in.substr(0, room), EditRec::Typing, true);
+        afterEdit();
+    }
+}
+
+// Per-character filter: a burst usually spans several keystrokes, so one
+// rejected character should not drop the rest.
+void UITextField::handleTextBurst(std::string_view text) {
+    if (!focused) return;
+    std::string in;
+    in.reserve(text.size());
+    for (char c : text) if (typedCharAllowed(inputType, c)) in += c;
+    insertTyped(in);
+}
+
+// count auto-repeats of Backspace/Delete as one edit: the selection (if
+// any) plus count - 1 further code points, or count without a selection.
+void UITextField::handleKeyRepeat(const SDL_KeyboardEvent& key, int count) {
+    if (!focused || count <= 0) return;
+    const std::string& s = linkedText.get();
+    const bool sel = hasSelection();
+    int a = sel ? selRange().first  : caret;
+    int b = sel ? selRange().second : caret;
+    int n = count - (sel ? 1 : 0);
+    if (key.keysym.sym == SDLK_BACKSPACE) {
+        while (n-- > 0 && a > 0) a = prevCodepoint(s, a);
+        if (a < b) replaceRange((size_t)a, (size_t)b, "", EditRec::Backspace, !sel);
+    } else if (key.keysym.sym == SDLK_DELETE) {
+        while (n-- > 0 && b < (int)s.size()) b = nextCodepoint(s, b);
+        if (a < b) replaceRange((size_t)a, (size_t)b, "", EditRec::DeleteKey, !sel);
+    } else {
+        return;
+    }
+    afterEdit();
+}
+
 void UITextField::handleEvent(const SDL_Event& e) {
     if (e.type == SDL_USEREVENT) {
         if (e.user.code == 0xF001) {
@@ -189,6 +334,8 @@ void UITextField::handleEvent(const SDL_Event& e) {
             if (focused) { focused = false; SDL_StopTextInput(); preedit.clear(); clearSelection(); cursorVisible = false; }
             return;
         }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; return; }
     }
     auto activeFont = font ? font : UIConfig::getDefaultFont();
     auto& textRef = linkedText.get();
@@ -196,13 +343,7 @@ void UITextField::handleEvent(const SDL_Event& e) {
     auto isInside = [&](int x, int y) {
         return x >= bounds.x && x < bounds.x + bounds.w && y >= bounds.y && y < bounds.y + bounds.h;
     };
-    auto innerR = [&]() {
-        if (borderPx <= 0) return bounds;
-        SDL_Rect r{bounds.x + borderPx, bounds.y + borderPx, bounds.w - 2 * borderPx, bounds.h - 2 * borderPx};
-        if (r.w < 0) r.w = 0;
-        if (r.h < 0) r.h = 0;
-        return r;
-    }();
+    const SDL_Rect innerR = innerRect();
 
     auto isCont = [](unsigned char c) { return (c & 0xC0) == 0x80; };
     auto nextCP = [&](const std::string& s, int i) {
@@ -249,65 +390,8 @@ void UITextField::handleEvent(const SDL_Event& e) {
         }
         return lastGood;
     };
-    auto ensureCaretVisibleLocal = [&]() {
-        if (!activeFont) return;
-
-        const int pad = 8;
-        int innerW = innerR.w - 2 * pad;
-        if (innerW < 0) innerW = 0;
-
-        rebuildGlyphX(activeFont);
-        const int w = prefixWidth(std::min<size_t>(caret, glyphX.size() ? glyphX.size()-1 : 0));
-
-        const int margin = 2;
-        const int left  = scrollX + margin;
-        const int right = scrollX + innerW - margin;
-
-        if (w < left) {
-            scrollX = std::max(0, w - margin);
-        } else if (w > right) {
-            scrollX = std::max(0, w - innerW + margin);
-        }
-
-        const int contentW = glyphX.empty() ? 0 : glyphX.back();
-        const int maxScroll = std::max(0, contentW - innerW);
-        if (scrollX > maxScroll) scrollX = maxScroll;
-    };
-    auto updateImeRect = [&]() {
-        if (!activeFont) return;
-        const int pad = 8;
-        const int cursorH = TTF_FontHeight(activeFont);
-
-        rebuildGlyphX(activeFont);
-        int wCaret = prefixWidth(std::min<size_t>(caret, glyphX.size() ? glyphX.size()-1 : 0));
-
-        if (!preedit.empty()) {
-            auto isContB = [](unsigned char c){ return (c & 0xC0) == 0x80; };
-            int preByte = 0, cpLeft = std::max(0, preeditCursor);
-            while (preByte < (int)preedit.size() && cpLeft-- > 0) {
-                preByte++;
-                while (preByte < (int)preedit.size() && isContB((unsigned char)preedit[preByte])) preByte++;
-            }
-
-            std::string preSub = (inputType == InputType::PASSWORD)
-                ? std::string((int)std::count_if(preedit.begin(), preedit.begin() + preByte,
-                    [&](unsigned char ch){ return !isContB(ch); }), '*')
-                : preedit.substr(0, preByte);
-
-            int wPre = 0, h = 0;
-            if (!preSub.empty()) TTF_SizeUTF8(activeFont, preSub.c_str(), &wPre, &h);
-            wCaret += wPre;
-        }
-
-        SDL_Rect r{ innerR.x + pad + wCaret - scrollX, innerR.y + (innerR.h - cursorH) / 2, 1, cursorH };
-        SDL_SetTextInputRect(&r);
-    };
-    auto postEditAdjust = [&](){
-        ensureCaretVisibleLocal();
-        updateImeRect();
-        cursorVisible  = true;
-        lastBlinkTicks = SDL_GetTicks();
-    };
+    auto ensureCaretVisibleLocal = [&]() { ensureCaretVisible(); };
+    auto postEditAdjust = [&]() { afterEdit(); };
     auto moveLeft = [&](bool word, bool withSel) {
         int oldCaret = caret;
         int c;
@@ -341,6 +425,7 @@ void UITextField::handleEvent(const SDL_Event& e) {
             if (e.button.button == SDL_BUTTON_LEFT) {
                 if (isInside(e.button.x, e.button.y)) {
                     if (!focused) { focused = true; SDL_StartTextInput(); }
+                    dragMouseX = e.button.x;
                     int oldCaret = caret;
                     caret = caretByteFromX(e.button.x);
                     Uint32 now = SDL_GetTicks();
@@ -389,8 +474,7 @@ void UITextField::handleEvent(const SDL_Event& e) {
                     SDL_CaptureMouse(SDL_TRUE);
                     ensureCaretVisibleLocal();
                     updateImeRect();
-                    cursorVisible = true;
-                    lastBlinkTicks = SDL_GetTicks();
+                    restartBlink();
                     return;
                 } else {
                     if (focused) { focused = false; SDL_StopTextInput(); preedit.clear(); clearSelection(); }
@@ -399,9 +483,9 @@ void UITextField::handleEvent(const SDL_Event& e) {
         } break;
 
         case SDL_MOUSEMOTION: {
+            dragMouseX = e.motion.x;
             if (selectingDrag) {
-                Uint32 btns = SDL_GetMouseState(nullptr, nullptr);
-                if ((btns & SDL_BUTTON(SDL_BUTTON_LEFT)) == 0) {
+                if ((e.motion.state & SDL_BUTTON_LMASK) == 0) {
                     selectingDrag = false;
                     SDL_CaptureMouse(SDL_FALSE);
                     if (!hasSelection()) clearSelection();
@@ -421,9 +505,7 @@ void UITextField::handleEvent(const SDL_Event& e) {
 
                 ensureCaretVisibleLocal();
                 updateImeRect();
-                lastInputTicks = SDL_GetTicks();
-                cursorVisible  = true;
-                lastBlinkTicks = lastInputTicks;
+                restartBlink(TYPING_HOLD_MS);
                 return;
             }
         } break;
@@ -513,8 +595,7 @@ void UITextField::handleEvent(const SDL_Event& e) {
                 }
                 ensureCaretVisibleLocal();
                 updateImeRect();
-                cursorVisible = true;
-                lastBlinkTicks = SDL_GetTicks();
+                restartBlink();
                 return;
             }
             if (key == SDLK_HOME) {
@@ -522,14 +603,14 @@ void UITextField::handleEvent(const SDL_Event& e) {
                 caret = 0;
                 if (shift) { if (selAnchor < 0) selAnchor = before; }
                 else { clearSelection(); selAnchor = caret; }
-                ensureCaretVisibleLocal(); updateImeRect(); cursorVisible = true; lastBlinkTicks = SDL_GetTicks(); return;
+                ensureCaretVisibleLocal(); updateImeRect(); restartBlink(); return;
             }
             if (key == SDLK_END) {
                 int before = caret;
                 caret = (int)textRef.size();
                 if (shift) { if (selAnchor < 0) selAnchor = before; }
                 else { clearSelection(); selAnchor = caret; }
-                ensureCaretVisibleLocal(); updateImeRect(); cursorVisible = true; lastBlinkTicks = SDL_GetTicks(); return;
+                ensureCaretVisibleLocal(); updateImeRect(); restartBlink(); return;
             }
             if (e.key.keysym.sym == SDLK_BACKSPACE) {
                 auto& s = linkedText.get();
@@ -573,27 +654,8 @@ void UITextField::handleEvent(const SDL_Event& e) {
         } break;
         case SDL_TEXTINPUT: {
             if (!focused) break;
-
-            std::string in = e.text.text;
-            bool valid = true;
-            switch (inputType) {
-                case InputType::NUMERIC: valid = std::all_of(in.begin(), in.end(), ::isdigit); break;
-                case InputType::EMAIL:   valid = std::all_of(in.begin(), in.end(), [](char c){ return std::isalnum((unsigned char)c) || c=='@'||c=='.'||c=='-'||c=='_';}); break;
-                default: break;
-            }
-            if (valid && !in.empty()) {
-                const auto& cur = linkedText.get();
-                size_t a = hasSelection() ? (size_t)selRange().first  : (size_t)caret;
-                size_t b = hasSelection() ? (size_t)selRange().second : (size_t)caret;
-
-                size_t maxLen = (maxLength > 0) ? (size_t)maxLength : SIZE_MAX;
-                size_t room   = (cur.size() - (b - a) < maxLen) ? (maxLen - (cur.size() - (b - a))) : 0;
-                if (room > 0) {
-                    if (in.size() > room) in.resize(room);
-                    replaceRange(a, b, in, EditRec::Typing, true);
-                    postEditAdjust();
-                }
-            }
+            // Same filtering as a coalesced burst, e.g. when forwarded by a container.
+            handleTextBurst(e.text.text);
             return;
         }
 
@@ -605,9 +667,7 @@ void UITextField::handleEvent(const SDL_Event& e) {
             preeditCursor = e.edit.start;
             updateImeRect();
             if (changed) {
-                lastInputTicks = SDL_GetTicks();
-                cursorVisible  = true;
-                lastBlinkTicks = lastInputTicks;
+                restartBlink(TYPING_HOLD_MS);
             }
             return;
         } break;
@@ -621,9 +681,7 @@ void UITextField::handleEvent(const SDL_Event& e) {
             preeditCursor = e.edit.start;
             updateImeRect();
             if (changed) {
-                lastInputTicks = SDL_GetTicks();
-                cursorVisible  = true;
-                lastBlinkTicks = lastInputTicks;
+                restartBlink(TYPING_HOLD_MS);
             }
             return;
         } break;
@@ -643,24 +701,19 @@ void UITextField::handleEvent(const SDL_Event& e) {
 void UITextField::update(float) {
     const std::string& textRef = linkedText.get();
     const int maxPos = (int)textRef.size();
+    // The bound string changes behind our back; report it to cached layers.
+    if (textRef != seenText) {
+        seenText = textRef;
+        markDirty();
+    }
     
     caret = std::clamp(caret, 0, maxPos);
     if (selAnchor >= 0) {
         selAnchor = std::clamp(selAnchor, 0, maxPos);
     }
     
-    int mx, my; SDL_GetMouseState(&mx, &my);
-    Uint32 btns = SDL_GetMouseState(nullptr, nullptr);
-    if (selectingDrag && (btns & SDL_BUTTON(SDL_BUTTON_LEFT)) == 0) {
-        selectingDrag = false;
-        SDL_CaptureMouse(SDL_FALSE);
-        if (!hasSelection()) clearSelection();
-    }
-
-    hovered = (mx >= bounds.x && mx < bounds.x + bounds.w &&
-               my >= bounds.y && my < bounds.y + bounds.h);
-
     if (focused && selectingDrag) {
+        const int mx = dragMouseX;
         TTF_Font* activeFont = font ? font : UIConfig::getDefaultFont();
         if (activeFont) {
             SDL_Rect innerR = (borderPx <= 0)
@@ -713,29 +766,26 @@ void UITextField::update(float) {
 
             if (lastGood != caret) {
                 caret = lastGood;
-                lastInputTicks = SDL_GetTicks();
-                cursorVisible  = true;
-                lastBlinkTicks = lastInputTicks;
+                restartBlink(TYPING_HOLD_MS);
             }
         }
     }
 
-    if (!enabled) { cursorVisible = false; return; }
-    if (!focused) { cursorVisible = false; return; }
+    if (!enabled || !focused) { stopBlink(); cursorVisible = false; return; }
+    if (timers && !timers->isActive(blinkTimer)) restartBlink();
+}
 
-    const Uint32 now          = SDL_GetTicks();
-    const Uint32 typingHoldMs = 300;
-    const Uint32 blinkMs      = 530;
+void UITextField::restartBlink(Uint32 holdMs) {
+    cursorVisible = true;
+    if (!timers) return;
+    timers->cancel(blinkTimer);
+    blinkTimer = timers->schedule(this, holdMs + BLINK_MS, BLINK_MS, [this]{ cursorVisible = !cursorVisible; markDirty(); });
+}
 
-    if (now - lastInputTicks < typingHoldMs) {
-        cursorVisible  = true;
-        lastBlinkTicks = now;
-    } else {
-        if (now - lastBlinkTicks >= blinkMs) {
-            cursorVisible  = !cursorVisible;
-            lastBlinkTicks = now;
-        }
-    }
+void UITextField::stopBlink() {
+    if (blinkTimer == UITimerWheel::InvalidTimer) return;
+    if (timers) timers->cancel(blinkTimer);
+    blinkTimer = UITimerWheel::InvalidTimer;
 }
 
 
@@ -744,8 +794,7 @@ void UITextField::render(SDL_Renderer* renderer) {
     if (!activeFont) return;
 
     const UITheme& th = getTheme();
-    const UIStyle& ds = getStyle();
-    const auto st = MakeTextFieldStyle(th, ds);
+    const auto st = resolvedStyle<UITextFieldStyle>();
 
     const int effRadius   = (cornerRadius > 0 ? cornerRadius : st.radius);
     const int effBorderPx = (borderPx     > 0 ? borderPx     : st.borderPx);
@@ -6,6 +6,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include "UICommon.hpp"
 #include <functional>
@@ -23,6 +24,9 @@ public:
 
     bool isHovered() const override;
     void handleEvent(const SDL_Event& e) override;
+    bool acceptsInputBursts() const override { return true; }
+    void handleTextBurst(std::string_view text) override;
+    void handleKeyRepeat(const SDL_KeyboardEvent& key, int count) override;
     void update(float dt) override;
     void render(SDL_Renderer* renderer) override;
     void undo();
@@ -66,6 +70,14 @@ private:
     void replaceRange(size_t a, size_t b, std::string_view repl, EditRec::Kind kind, bool tryCoalesce);
     void applyReplaceNoHistory(size_t a, size_t b, std::string_view repl,
                            size_t newCursor, int newSelA, int newSelB);
+    void restartBlink(Uint32 holdMs = 0);
+    void stopBlink();
+    SDL_Rect innerRect() const;
+    void ensureCaretVisible();
+    void updateImeRect();
+    void afterEdit();
+    // TEXTINPUT path shared with handleTextBurst; clamps to maxLength.
+    void insertTyped(std::string_view in);
 
     std::vector<EditRec> undoStack;
     std::vector<EditRec> redoStack;
@@ -73,11 +85,11 @@ private:
     Uint32 coalesceMs{350};
     std::string label;
     std::reference_wrapper<std::string> linkedText;
+    std::string seenText;
     int maxLength = 32;
     bool hovered = false;
     bool focused = false;
     bool focusable = true;
-    Uint32 lastBlinkTime = 0;
     bool cursorVisible = true;
     std::string placeholder;
     SDL_Color placeholderColor = {160, 160, 160, 255};
@@ -85,11 +97,11 @@ private:
     InputType inputType = InputType::TEXT;
     int cornerRadius = 10;
     int borderPx     = 1;
-    Uint32 lastInputTicks = 0;
-    Uint32 lastBlinkTicks = 0;
+    UITimerWheel::TimerId blinkTimer = UITimerWheel::InvalidTimer;
     int caret = 0;
     int selAnchor = -1;
     bool selectingDrag = false;
+    int dragMouseX = 0;
     int scrollX = 0;
     Uint32 lastClickTicks = 0;
     std::string preedit;
@@ -0,0 +1,95 @@
+#include "UITextRowCache.hpp"
+#include <algorithm>
+
+static int roundUp64(int v) { return (v + 63) & ~63; }
+
+static bool sameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+void UITextRowCache::setCapacity(size_t rows) {
+    rows = std::max<size_t>(rows, 1);
+    if (rows == slots_.size()) return;
+    slots_.clear();
+    slots_.resize(rows);
+}
+
+void UITextRowCache::invalidate(size_t key) {
+    if (slots_.empty()) return;
+    Slot& s = slots_[key % slots_.size()];
+    if (s.key == key) s.gen = 0;
+}
+
+void UITextRowCache::clear() {
+    for (Slot& s : slots_) s = Slot{};
+}
+
+void UITextRowCache::claim_(Slot& s, SDL_Renderer* r, TTF_Font* font, size_t key, int maxW) {
+    ++misses_;
+    s.key = key;
+    s.gen = gen_;
+    s.font = font;
+    s.maxW = maxW;
+    s.w = s.h = 0;
+    if (s.renderer != r) {
+        s.tex.reset();
+        s.texW = s.texH = 0;
+        s.renderer = r;
+    }
+}
+
+UITextRowCache::Row UITextRowCache::get(SDL_Renderer* r, TTF_Font* font, SDL_Color color, size_t key,
+                                        int maxW, const std::function<std::string()>& text) {
+    if (slots_.empty() || !r || !font) return {};
+    Slot& s = slots_[key % slots_.size()];
+    if (s.key == key && s.gen == gen_ && s.font == font && s.renderer == r &&
+        s.maxW == maxW && !s.drawn && sameColor(s.color, color))
+        return { s.w > 0 ? s.tex.get() : nullptr, s.w, s.h };
+
+    claim_(s, r, font, key, maxW);
+    s.drawn = false;
+    s.color = color;
+
+    const std::string str = text ? text() : std::string();
+    if (str.empty() || maxW <= 0) return {};
+    return upload_(s, r, UIHelpers::MakeSurface(TTF_RenderUTF8_Blended(font, str.c_str(), color)), maxW);
+}
+
+UITextRowCache::Row UITextRowCache::get(SDL_Renderer* r, TTF_Font* font, size_t key, Uint64 stamp, int maxW,
+                                        const std::function<UIHelpers::UniqueSurface()>& draw) {
+    if (slots_.empty() || !r || !font) return {};
+    Slot& s = slots_[key % slots_.size()];
+    if (s.key == key && s.gen == gen_ && s.font == font && s.renderer == r &&
+        s.maxW == maxW && s.drawn && s.stamp == stamp)
+        return { s.w > 0 ? s.tex.get() : nullptr, s.w, s.h };
+
+    claim_(s, r, font, key, maxW);
+    s.drawn = true;
+    s.stamp = stamp;
+    if (maxW <= 0 || !draw) return {};
+    return upload_(s, r, draw(), maxW);
+}
+
+UITextRowCache::Row UITextRowCache::upload_(Slot& s, SDL_Renderer* r, UIHelpers::UniqueSurface surf, int maxW) {
+    if (!surf) return {};
+    if (surf->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        surf = UIHelpers::MakeSurface(SDL_ConvertSurfaceFormat(surf.get(), SDL_PIXELFORMAT_ARGB8888, 0));
+        if (!surf) return {};
+    }
+
+    const int w = std::min(surf->w, maxW), h = surf->h;
+    if (!s.tex || w > s.texW || h > s.texH) {
+        const int tw = std::max(s.texW, roundUp64(w)), th = std::max(s.texH, h);
+        s.tex = UIHelpers::MakeTexture(
+            SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, tw, th));
+        if (!s.tex) { s.texW = s.texH = 0; return {}; }
+        SDL_SetTextureBlendMode(s.tex.get(), SDL_BLENDMODE_BLEND);
+        s.texW = tw;
+        s.texH = th;
+    }
+    const SDL_Rect dst{ 0, 0, w, h };
+    if (SDL_UpdateTexture(s.tex.get(), &dst, surf->pixels, surf->pitch) != 0) return {};
+    s.w = w;
+    s.h = h;
+    return { s.tex.get(), w, h };
+}
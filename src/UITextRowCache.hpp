@@ -0,0 +1,60 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "UIHelpers.hpp"
+
+// Text textures for virtualized rows, direct-mapped by item index into a
+// fixed pool. When a new item lands on a slot its streaming texture is
+// rewritten in place, so scrolling through a large model stops allocating
+// once the pool is warm. Keep the capacity at or above the visible row count.
+class UITextRowCache {
+public:
+    struct Row {
+        SDL_Texture* texture = nullptr;   // draw src {0, 0, w, h}
+        int w = 0, h = 0;
+    };
+
+    explicit UITextRowCache(size_t capacity = 64) { setCapacity(capacity); }
+
+    void   setCapacity(size_t rows);
+    size_t capacity() const { return slots_.size(); }
+    // The model changed: every row is re-rasterized on next use.
+    void   invalidateAll() { ++gen_; }
+    void   invalidate(size_t key);
+    void   clear();
+
+    // text() is only called on a miss. Output is clipped to maxW pixels.
+    Row get(SDL_Renderer* r, TTF_Font* font, SDL_Color color, size_t key, int maxW,
+            const std::function<std::string()>& text);
+    // Rows composed by the caller, e.g. several colors. draw() is only called
+    // when the slot holds another key or stamp; change the stamp whenever the
+    // row's content does.
+    Row get(SDL_Renderer* r, TTF_Font* font, size_t key, Uint64 stamp, int maxW,
+            const std::function<UIHelpers::UniqueSurface()>& draw);
+
+    Uint64 misses() const { return misses_; }
+
+private:
+    struct Slot {
+        size_t key = (size_t)-1;
+        Uint64 gen = 0;
+        TTF_Font* font = nullptr;
+        SDL_Color color{ 0, 0, 0, 0 };
+        int maxW = 0;
+        bool drawn = false;          // filled by the stamped get()
+        Uint64 stamp = 0;
+        UIHelpers::UniqueTexture tex;
+        SDL_Renderer* renderer = nullptr;
+        int texW = 0, texH = 0;
+        int w = 0, h = 0;
+    };
+    void claim_(Slot& s, SDL_Renderer* r, TTF_Font* font, size_t key, int maxW);
+    Row upload_(Slot& s, SDL_Renderer* r, UIHelpers::UniqueSurface surf, int maxW);
+
+    std::vector<Slot> slots_;
+    Uint64 gen_ = 1;
+    Uint64 misses_ = 0;
+};
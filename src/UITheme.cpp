@@ -54,4 +54,33 @@ UITheme MakeHighContrastTheme() {
     t.checkboxTickColor = {255,255,0,255};
     t.cursorColor       = {255,255,255,255};
     return t;
-}
\ No newline at end of file
+}
+
+namespace {
+const SDL_Color UITheme::* const kThemeColors[] = {
+    &UITheme::backgroundColor, &UITheme::hoverColor, &UITheme::borderColor,
+    &UITheme::borderHoverColor, &UITheme::textColor, &UITheme::placeholderColor,
+    &UITheme::cursorColor, &UITheme::sliderTrackColor, &UITheme::sliderThumbColor,
+    &UITheme::checkboxTickColor, &UITheme::focusRing, &UITheme::selectionBg,
+};
+
+bool sameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+}
+
+bool operator==(const UITheme& a, const UITheme& b) {
+    for (auto m : kThemeColors)
+        if (!sameColor(a.*m, b.*m)) return false;
+    return a.font == b.font;
+}
+
+size_t HashValue(const UITheme& t) {
+    Uint64 h = 1469598103934665603ull;
+    for (auto m : kThemeColors) {
+        const SDL_Color c = t.*m;
+        h = (h ^ ((Uint32)c.r | (Uint32)c.g << 8 | (Uint32)c.b << 16 | (Uint32)c.a << 24)) * 1099511628211ull;
+    }
+    h = (h ^ (Uint64)(uintptr_t)t.font) * 1099511628211ull;
+    return (size_t)h;
+}
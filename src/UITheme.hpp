@@ -42,3 +42,7 @@ UITheme MakeDarkTheme();
 UITheme MakeHighContrastTheme();
 
 TTF_Font* getThemeFont(const UITheme& theme);
+
+bool operator==(const UITheme& a, const UITheme& b);
+inline bool operator!=(const UITheme& a, const UITheme& b) { return !(a == b); }
+size_t HashValue(const UITheme& t);
@@ -0,0 +1,191 @@
+#include "UITimerWheel.hpp"
+#include <climits>
+
+namespace {
+// Gaps longer than this (suspend, debugger) are handled by re-bucketing
+// everything instead of stepping the wheel one millisecond at a time.
+constexpr Uint64 MAX_STEP_GAP = 1u << 16;
+}
+
+UITimerWheel::TimerId UITimerWheel::nextId_ = 1;
+
+UITimerWheel::UITimerWheel() : lastTicks_(SDL_GetTicks()) {}
+
+Uint64 UITimerWheel::nowMs_() const {
+    return now_ + (Uint32)(SDL_GetTicks() - lastTicks_);
+}
+
+UITimerWheel::TimerId UITimerWheel::schedule(const void* owner, Uint32 delayMs, Uint32 periodMs, std::function<void()> cb) {
+    if (!cb) return InvalidTimer;
+
+    Uint32 n;
+    if (!free_.empty()) {
+        n = free_.back();
+        free_.pop_back();
+    } else {
+        n = (Uint32)nodes_.size();
+        nodes_.emplace_back();
+    }
+    Node& node = nodes_[n];
+    node.id       = nextId_++;
+    node.owner    = owner;
+    node.deadline = nowMs_() + delayMs;
+    node.period   = periodMs;
+    node.cb       = std::move(cb);
+    index_[node.id] = n;
+    insert_(n);
+    return node.id;
+}
+
+bool UITimerWheel::cancel(TimerId id) {
+    auto it = index_.find(id);
+    if (it == index_.end()) return false;
+    Node& node = nodes_[it->second];
+    node.id = InvalidTimer;
+    node.owner = nullptr;
+    node.cb = nullptr;
+    index_.erase(it);
+    return true;
+}
+
+void UITimerWheel::cancelAll(const void* owner) {
+    if (!owner) return;
+    for (auto it = index_.begin(); it != index_.end(); ) {
+        Node& node = nodes_[it->second];
+        if (node.owner == owner) {
+            node.id = InvalidTimer;
+            node.owner = nullptr;
+            node.cb = nullptr;
+            it = index_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UITimerWheel::insert_(Uint32 n) {
+    Node& node = nodes_[n];
+    if (node.deadline <= now_) node.deadline = now_ + 1;
+    const Uint64 d = node.deadline;
+    for (int level = 0; level < LEVELS; ++level) {
+        const int shift = SLOT_BITS * (level + 1);
+        if ((d >> shift) == (now_ >> shift)) {
+            wheel_[level][(d >> (SLOT_BITS * level)) & SLOT_MASK].push_back(n);
+            return;
+        }
+    }
+    overflow_.push_back(n);
+}
+
+// Slots own dead nodes until they are visited, so a cancelled index is never
+// reused while something still refers to it.
+void UITimerWheel::release_(Uint32 n) {
+    free_.push_back(n);
+}
+
+void UITimerWheel::cascade_(int level) {
+    std::vector<Uint32> moved;
+    if (level >= LEVELS) {
+        moved.swap(overflow_);
+    } else {
+        moved.swap(wheel_[level][(now_ >> (SLOT_BITS * level)) & SLOT_MASK]);
+    }
+    for (Uint32 n : moved) {
+        if (nodes_[n].id == InvalidTimer) release_(n);
+        else if (nodes_[n].deadline == now_) wheel_[0][now_ & SLOT_MASK].push_back(n);
+        else insert_(n);
+    }
+}
+
+void UITimerWheel::expire_(std::vector<Uint32>& slot, Uint64 target) {
+    if (slot.empty()) return;
+    std::vector<Uint32> due;
+    due.swap(slot);
+    for (Uint32 n : due) {
+        const TimerId id = nodes_[n].id;
+        if (id == InvalidTimer) { release_(n); continue; }
+        if (nodes_[n].deadline > now_) { insert_(n); continue; }
+
+        std::function<void()> cb = std::move(nodes_[n].cb);
+        const Uint32 period = nodes_[n].period;
+        if (period == 0) {
+            index_.erase(id);
+            nodes_[n].id = InvalidTimer;
+            nodes_[n].owner = nullptr;
+            release_(n);
+            cb();
+            continue;
+        }
+
+        cb();
+        // The callback may have scheduled timers (nodes_ may have grown) or
+        // cancelled this one, in which case no slot refers to it any more.
+        Node& node = nodes_[n];
+        if (node.id != id) { release_(n); continue; }
+        node.cb = std::move(cb);
+        Uint64 next = node.deadline + period;
+        if (next <= target) next += ((target - next) / period + 1) * period;
+        node.deadline = next;
+        insert_(n);
+    }
+}
+
+void UITimerWheel::rebuild_(Uint64 target) {
+    std::vector<Uint32> live;
+    auto collect = [&](std::vector<Uint32>& slot) {
+        for (Uint32 n : slot) {
+            if (nodes_[n].id == InvalidTimer) release_(n);
+            else live.push_back(n);
+        }
+        slot.clear();
+    };
+    for (auto& level : wheel_)
+        for (auto& slot : level) collect(slot);
+    collect(overflow_);
+
+    now_ = target - 1;
+    for (Uint32 n : live) insert_(n);
+}
+
+void UITimerWheel::advance(Uint32 nowTicks) {
+    const Uint64 target = now_ + (Uint32)(nowTicks - lastTicks_);
+    lastTicks_ = nowTicks;
+    if (index_.empty()) { now_ = target; return; }
+    if (target - now_ > MAX_STEP_GAP) rebuild_(target);
+
+    while (now_ < target) {
+        ++now_;
+        int top = 0;
+        while (top < LEVELS && (now_ & ((Uint64(1) << (SLOT_BITS * (top + 1))) - 1)) == 0) ++top;
+        for (int level = top; level >= 1; --level) cascade_(level);
+        expire_(wheel_[0][now_ & SLOT_MASK], target);
+    }
+}
+
+int UITimerWheel::msUntilNext() const {
+    if (index_.empty()) return -1;
+
+    Uint64 earliest = 0;
+    bool found = false;
+    auto scan = [&](const std::vector<Uint32>& slot) {
+        for (Uint32 n : slot) {
+            const Node& node = nodes_[n];
+            if (node.id == InvalidTimer) continue;
+            if (!found || node.deadline < earliest) earliest = node.deadline;
+            found = true;
+        }
+    };
+    // Each level only holds deadlines later than every level below it, so
+    // the first live slot found walking upward contains the minimum.
+    for (int level = 0; level < LEVELS && !found; ++level) {
+        const Uint64 cur = (now_ >> (SLOT_BITS * level)) & SLOT_MASK;
+        for (Uint64 s = cur + 1; s < (Uint64)SLOTS && !found; ++s) scan(wheel_[level][s]);
+    }
+    if (!found) scan(overflow_);
+    if (!found) return -1;
+
+    const Uint64 now = nowMs_();
+    if (earliest <= now) return 0;
+    const Uint64 wait = earliest - now;
+    return wait > (Uint64)INT_MAX ? INT_MAX : (int)wait;
+}
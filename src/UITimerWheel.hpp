@@ -0,0 +1,71 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Hierarchical timer wheel with 1 ms resolution. Four levels of 64 slots
+// cover ~4.6 hours; anything further out waits in an overflow list.
+// Not thread-safe: schedule, cancel and advance from the UI thread only.
+class UITimerWheel {
+public:
+    using TimerId = Uint64;
+    static constexpr TimerId InvalidTimer = 0;
+
+    UITimerWheel();
+    UITimerWheel(const UITimerWheel&) = delete;
+    UITimerWheel& operator=(const UITimerWheel&) = delete;
+
+    // periodMs == 0 makes a one-shot timer. owner is only used by cancelAll().
+    TimerId schedule(const void* owner, Uint32 delayMs, Uint32 periodMs, std::function<void()> cb);
+    TimerId after(const void* owner, Uint32 delayMs, std::function<void()> cb) {
+        return schedule(owner, delayMs, 0, std::move(cb));
+    }
+    TimerId every(const void* owner, Uint32 periodMs, std::function<void()> cb) {
+        return schedule(owner, periodMs, periodMs, std::move(cb));
+    }
+
+    bool cancel(TimerId id);
+    void cancelAll(const void* owner);
+    bool isActive(TimerId id) const { return index_.count(id) != 0; }
+    size_t size() const { return index_.size(); }
+
+    // Fires everything due up to nowTicks (SDL_GetTicks() time base).
+    void advance(Uint32 nowTicks);
+
+    // Milliseconds until the earliest pending timer, 0 if one is already due,
+    // -1 if nothing is scheduled. Suitable for SDL_WaitEventTimeout().
+    int msUntilNext() const;
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr Uint64 SLOT_MASK = SLOTS - 1;
+
+    struct Node {
+        TimerId id = InvalidTimer;
+        const void* owner = nullptr;
+        Uint64 deadline = 0;
+        Uint32 period = 0;
+        std::function<void()> cb;
+    };
+
+    Uint64 nowMs_() const;
+    void insert_(Uint32 node);
+    void release_(Uint32 node);
+    void cascade_(int level);
+    void expire_(std::vector<Uint32>& slot, Uint64 target);
+    void rebuild_(Uint64 target);
+
+    std::vector<Node> nodes_;
+    std::vector<Uint32> free_;
+    std::unordered_map<TimerId, Uint32> index_;
+    std::array<std::array<std::vector<Uint32>, SLOTS>, LEVELS> wheel_;
+    std::vector<Uint32> overflow_;
+
+    Uint64 now_ = 0;
+    Uint32 lastTicks_ = 0;
+    static TimerId nextId_;
+};
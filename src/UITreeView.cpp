@@ -0,0 +1,411 @@
+#include "UITreeView.hpp"
+#include <algorithm>
+
+static constexpr int WHEEL_ROWS    = 3;
+static constexpr int ROW_PAD_Y     = 8;
+static constexpr int EXPANDER_PX   = 14;
+static constexpr size_t NO_ROW     = (size_t)-1;
+
+UITreeView::UITreeView(int x, int y, int w, int h) : nodes(1) {
+    bounds = { x, y, w, h };
+    nodes[Root].expanded = true;
+    nodes[Root].loaded = true;
+}
+
+UITreeView* UITreeView::setLoader(Loader fn) {
+    loader = std::move(fn);
+    nodes.assign(1, Node{});
+    freeNodes.clear();
+    rows.clear();
+    nodes[Root].expanded = true;
+    nodes[Root].hasChildren = true;
+    selectedNode = InvalidNode;
+    ensureLoaded_(Root);
+    appendVisible_(Root, rows);
+    rowsChanged_();
+    return this;
+}
+
+UITreeView::NodeId UITreeView::alloc_(const Child& c, NodeId parent) {
+    NodeId id;
+    if (!freeNodes.empty()) { id = freeNodes.back(); freeNodes.pop_back(); }
+    else { id = (NodeId)nodes.size(); nodes.emplace_back(); }
+    Node& n = nodes[id];
+    n = Node{};
+    n.label = c.label;
+    n.data = c.data;
+    n.parent = parent;
+    n.depth = nodes[parent].depth + 1;
+    n.hasChildren = c.hasChildren;
+    return id;
+}
+
+void UITreeView::freeChildren_(NodeId node) {
+    std::vector<NodeId> stack(nodes[node].children);
+    nodes[node].children.clear();
+    while (!stack.empty()) {
+        const NodeId id = stack.back();
+        stack.pop_back();
+        for (NodeId c : nodes[id].children) stack.push_back(c);
+        if (id == selectedNode) selectedNode = InvalidNode;
+        nodes[id] = Node{};
+        freeNodes.push_back(id);
+    }
+}
+
+void UITreeView::ensureLoaded_(NodeId node) {
+    if (nodes[node].loaded) return;
+    nodes[node].loaded = true;
+    if (!loader || !nodes[node].hasChildren) return;
+    const std::vector<Child> kids = loader(node);
+    nodes[node].children.reserve(kids.size());
+    for (const Child& c : kids) {
+        const NodeId id = alloc_(c, node);
+        nodes[node].children.push_back(id);
+    }
+    if (node != Root) nodes[node].hasChildren = !kids.empty();
+}
+
+void UITreeView::appendVisible_(NodeId node, std::vector<NodeId>& out) const {
+    for (NodeId c : nodes[node].children) {
+        out.push_back(c);
+        if (nodes[c].expanded) appendVisible_(c, out);
+    }
+}
+
+bool UITreeView::isShown_(NodeId node) const {
+    for (NodeId p = nodes[node].parent; p != InvalidNode; p = nodes[p].parent)
+        if (!nodes[p].expanded) return false;
+    return true;
+}
+
+size_t UITreeView::rowOf_(NodeId node) const {
+    auto it = std::find(rows.begin(), rows.end(), node);
+    return it == rows.end() ? NO_ROW : (size_t)(it - rows.begin());
+}
+
+// Rows after `row` that are deeper than it belong to its visible subtree.
+size_t UITreeView::subtreeEnd_(size_t row) const {
+    const int d = nodes[rows[row]].depth;
+    size_t end = row + 1;
+    while (end < rows.size() && nodes[rows[end]].depth > d) ++end;
+    return end;
+}
+
+void UITreeView::expandRow_(size_t row) {
+    const NodeId id = rows[row];
+    if (nodes[id].expanded || !nodes[id].hasChildren) return;
+    ensureLoaded_(id);
+    nodes[id].expanded = true;
+    std::vector<NodeId> sub;
+    appendVisible_(id, sub);
+    rows.insert(rows.begin() + row + 1, sub.begin(), sub.end());
+    rowsChanged_();
+}
+
+void UITreeView::collapseRow_(size_t row) {
+    const NodeId id = rows[row];
+    if (!nodes[id].expanded) return;
+    nodes[id].expanded = false;
+    const size_t end = subtreeEnd_(row);
+    const size_t sel = selectedRow_();
+    rows.erase(rows.begin() + row + 1, rows.begin() + end);
+    rowsChanged_();
+    // A hidden selection moves to the collapsed node.
+    if (sel != NO_ROW && sel > row && sel < end) {
+        selectedNode = InvalidNode;
+        selectRow_(row);
+    }
+}
+
+void UITreeView::rowsChanged_() {
+    text.invalidateAll();
+    selRowValid = false;
+    hoverRow = NO_ROW;
+    setScroll_(bars.offset(1));
+    markDirty();
+}
+
+void UITreeView::expand(NodeId node) {
+    if (node == Root || node >= nodes.size()) return;
+    if (!isShown_(node)) {
+        ensureLoaded_(node);
+        nodes[node].expanded = nodes[node].hasChildren;
+        return;
+    }
+    const size_t row = rowOf_(node);
+    if (row != NO_ROW) expandRow_(row);
+}
+
+void UITreeView::collapse(NodeId node) {
+    if (node == Root || node >= nodes.size()) return;
+    if (!isShown_(node)) { nodes[node].expanded = false; return; }
+    const size_t row = rowOf_(node);
+    if (row != NO_ROW) collapseRow_(row);
+}
+
+void UITreeView::toggle(NodeId node) {
+    if (isExpanded(node)) collapse(node);
+    else expand(node);
+}
+
+bool UITreeView::isExpanded(NodeId node) const {
+    return node < nodes.size() && nodes[node].expanded;
+}
+
+void UITreeView::setChildren(NodeId node, std::vector<Child> children) {
+    if (node >= nodes.size()) return;
+    const bool wasExpanded = nodes[node].expanded;
+    if (node != Root) collapse(node);
+    freeChildren_(node);
+    for (const Child& c : children) {
+        const NodeId id = alloc_(c, node);
+        nodes[node].children.push_back(id);
+    }
+    nodes[node].loaded = true;
+    if (node == Root) {
+        rows.clear();
+        appendVisible_(Root, rows);
+        rowsChanged_();
+        return;
+    }
+    nodes[node].hasChildren = !children.empty();
+    if (wasExpanded) expand(node);
+}
+
+void UITreeView::reload(NodeId node) {
+    if (node >= nodes.size()) return;
+    if (node == Root) { setLoader(loader); return; }
+    const bool wasExpanded = nodes[node].expanded;
+    collapse(node);
+    freeChildren_(node);
+    nodes[node].loaded = false;
+    nodes[node].hasChildren = true;
+    if (wasExpanded) expand(node);
+    else markDirty();
+}
+
+size_t UITreeView::selectedRow_() const {
+    if (selectedNode == InvalidNode) return NO_ROW;
+    if (!selRowValid) {
+        selRow = rowOf_(selectedNode);
+        selRowValid = true;
+    }
+    return selRow;
+}
+
+void UITreeView::selectRow_(size_t row) {
+    if (row >= rows.size()) return;
+    scrollToRow_(row);
+    selRow = row;
+    selRowValid = true;
+    if (rows[row] == selectedNode) return;
+    selectedNode = rows[row];
+    markDirty();
+    if (onSelectionChanged) onSelectionChanged(selectedNode);
+}
+
+void UITreeView::select(NodeId node, bool scrollIntoView) {
+    if (node == Root || node >= nodes.size()) return;
+    std::vector<NodeId> chain;
+    for (NodeId p = nodes[node].parent; p != Root && p != InvalidNode; p = nodes[p].parent) chain.push_back(p);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) expand(*it);
+    const size_t row = rowOf_(node);
+    if (row == NO_ROW) return;
+    if (scrollIntoView) { selectRow_(row); return; }
+    selRow = row;
+    selRowValid = true;
+    if (node == selectedNode) return;
+    selectedNode = node;
+    markDirty();
+    if (onSelectionChanged) onSelectionChanged(node);
+}
+
+UITreeView* UITreeView::setFont(TTF_Font* f) {
+    font = f;
+    setScroll_(bars.offset(1));
+    markDirty();
+    return this;
+}
+
+UITreeView* UITreeView::setRowHeight(int px) {
+    rowH = std::max(0, px);
+    setScroll_(bars.offset(1));
+    markDirty();
+    return this;
+}
+
+TTF_Font* UITreeView::activeFont_() const {
+    if (font) return font;
+    const UITheme& th = getTheme();
+    return th.font ? th.font : UIConfig::getDefaultFont();
+}
+
+int UITreeView::rowHeight() const {
+    if (rowH > 0) return rowH;
+    TTF_Font* f = activeFont_();
+    return f ? TTF_FontHeight(f) + ROW_PAD_Y : 24;
+}
+
+UIScrollBars::Layout UITreeView::layout_() const {
+    const int b = resolvedStyle<UIListBoxStyle>().borderPx;
+    const SDL_Rect area{ bounds.x + b, bounds.y + b, std::max(0, bounds.w - 2*b), std::max(0, bounds.h - 2*b) };
+    return bars.layout(area, 0.0, (double)rows.size() * rowHeight());
+}
+
+int UITreeView::visibleRows_() const {
+    return std::max(1, layout_().view.h / std::max(1, rowHeight()));
+}
+
+void UITreeView::setScroll_(double y) {
+    if (bars.setOffset(layout_(), 1, y)) markDirty();
+}
+
+void UITreeView::scrollToRow_(size_t row) {
+    const double rh = rowHeight();
+    setScroll_(bars.reveal(layout_(), 1, row * rh, rh));
+}
+
+void UITreeView::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_USEREVENT) {
+        if (e.user.code == 0xF001) { focused = true;  return; }
+        if (e.user.code == 0xF002) { focused = false; bars.cancelDrag(); return; }
+        if (e.user.code == 0xF003) { hovered = true;  return; }
+        if (e.user.code == 0xF004) { hovered = false; hoverRow = NO_ROW; return; }
+    }
+    if (!enabled) return;
+    if (e.type == SDL_MOUSEWHEEL && !hovered) return;
+
+    const UIScrollBars::Layout l = layout_();
+    if (bars.handleMouse(e, l, (double)WHEEL_ROWS * rowHeight(), [this](int, double y) { setScroll_(y); })) return;
+
+    if (e.type == SDL_MOUSEMOTION) {
+        hoverRow = bars.rowAt(l, e.motion.x, e.motion.y, rowHeight(), rows.size());
+        return;
+    }
+
+    if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+        const SDL_Point p{ e.button.x, e.button.y };
+        if (!SDL_PointInRect(&p, &bounds)) return;
+        const size_t r = bars.rowAt(l, p.x, p.y, rowHeight(), rows.size());
+        if (r == NO_ROW) return;
+        const NodeId id = rows[r];
+        // Same origin as the chevron in render().
+        const int ex = l.view.x + resolvedStyle<UIListBoxStyle>().padX / 2 + nodes[id].depth * indentPx;
+        if (nodes[id].hasChildren && p.x >= ex && p.x < ex + EXPANDER_PX + 6) {
+            if (nodes[id].expanded) collapseRow_(r); else expandRow_(r);
+            return;
+        }
+        selectRow_(r);
+        if (e.button.clicks >= 2) {
+            if (nodes[id].hasChildren) { if (nodes[id].expanded) collapseRow_(r); else expandRow_(r); }
+            if (onActivate) onActivate(id);
+        }
+        return;
+    }
+
+    if (!focused || e.type != SDL_KEYDOWN) return;
+    const size_t n = rows.size();
+    if (n == 0) return;
+    const size_t cur = selectedRow_();
+    const long long page = std::max(1, visibleRows_() - 1);
+    auto move = [&](long long delta) {
+        const long long from = cur == NO_ROW ? (delta > 0 ? -1 : (long long)n) : (long long)cur;
+        selectRow_((size_t)std::clamp(from + delta, 0LL, (long long)n - 1));
+    };
+    switch (e.key.keysym.sym) {
+        case SDLK_UP:       move(-1); break;
+        case SDLK_DOWN:     move(1); break;
+        case SDLK_PAGEUP:   move(-page); break;
+        case SDLK_PAGEDOWN: move(page); break;
+        case SDLK_HOME:     selectRow_(0); break;
+        case SDLK_END:      selectRow_(n - 1); break;
+        case SDLK_RIGHT:
+            if (cur == NO_ROW) break;
+            if (nodes[rows[cur]].hasChildren && !nodes[rows[cur]].expanded) expandRow_(cur);
+            else if (cur + 1 < rows.size() && nodes[rows[cur + 1]].parent == rows[cur]) selectRow_(cur + 1);
+            break;
+        case SDLK_LEFT:
+            if (cur == NO_ROW) break;
+            if (nodes[rows[cur]].expanded) collapseRow_(cur);
+            else if (nodes[rows[cur]].parent != Root) select(nodes[rows[cur]].parent);
+            break;
+        case SDLK_RETURN:
+        case SDLK_KP_ENTER:
+            if (cur == NO_ROW) break;
+            if (nodes[rows[cur]].hasChildren) { if (nodes[rows[cur]].expanded) collapseRow_(cur); else expandRow_(cur); }
+            if (onActivate && selectedNode != InvalidNode) onActivate(selectedNode);
+            break;
+        default: break;
+    }
+}
+
+void UITreeView::update(float) {}
+
+void UITreeView::render(SDL_Renderer* renderer) {
+    if (!visible) return;
+    const auto st = resolvedStyle<UIListBoxStyle>();
+    TTF_Font* f = activeFont_();
+
+    const LookStamp look = lookStamp();
+    if (look != seenLook) { seenLook = look; text.invalidateAll(); }
+
+    SDL_Color borderNow = focused ? st.borderFocus : (hovered ? st.borderHover : st.border);
+    if (st.borderPx > 0) {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, borderNow);
+        UIHelpers::FillRoundedRect(renderer, bounds.x + st.borderPx, bounds.y + st.borderPx,
+                                   bounds.w - 2*st.borderPx, bounds.h - 2*st.borderPx,
+                                   std::max(0, st.radius - st.borderPx), st.bg);
+    } else {
+        UIHelpers::FillRoundedRect(renderer, bounds.x, bounds.y, bounds.w, bounds.h, st.radius, st.bg);
+    }
+    if (rows.empty()) return;
+
+    const UIScrollBars::Layout l = layout_();
+    const SDL_Rect in = l.view;
+    const int rh = std::max(1, rowHeight());
+    text.setCapacity((size_t)(in.h / rh) + 2);
+
+    SDL_Rect prevClip;
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer);
+    SDL_RenderGetClipRect(renderer, &prevClip);
+    SDL_Rect clip = in;
+    if (hadClip) SDL_IntersectRect(&prevClip, &in, &clip);
+    SDL_RenderSetClipRect(renderer, &clip);
+
+    const double scrollY = bars.offset(1);
+    const size_t first = (size_t)(scrollY / rh);
+    const int y0 = in.y - (int)(scrollY - (double)first * rh);
+    const size_t sel = selectedRow_();
+    for (size_t r = first; r < rows.size(); ++r) {
+        const int y = y0 + (int)(r - first) * rh;
+        if (y >= in.y + in.h) break;
+        const Node& node = nodes[rows[r]];
+        const bool isSel = (r == sel);
+        if (isSel || r == hoverRow)
+            UIHelpers::FillRoundedRect(renderer, in.x + 4, y + 2, in.w - 8, rh - 4, 6, isSel ? st.selectedBg : st.hoverBg);
+
+        SDL_Color fg = isSel ? st.selectedFg : st.fg;
+        if (!enabled) fg.a = 160;
+        const int x = in.x + st.padX / 2 + node.depth * indentPx;
+        if (node.hasChildren) {
+            const float cx = (float)(x + EXPANDER_PX / 2), cy = (float)(y + rh / 2);
+            if (node.expanded) {
+                UIHelpers::DrawChevronDown(renderer, (int)cx, (int)cy, 9, 5, 1.5f, fg);
+            } else {
+                UIHelpers::DrawRoundStrokeLine(renderer, cx - 2, cy - 4, cx + 2, cy, 1.5f, fg);
+                UIHelpers::DrawRoundStrokeLine(renderer, cx + 2, cy, cx - 2, cy + 4, 1.5f, fg);
+            }
+        }
+        if (!f) continue;
+        const int tx = x + EXPANDER_PX + 4;
+        const auto t = text.get(renderer, f, fg, r, in.x + in.w - st.padX - tx, [&] { return node.label; });
+        if (!t.texture) continue;
+        const SDL_Rect src{ 0, 0, t.w, t.h };
+        const SDL_Rect dst{ tx, y + (rh - t.h) / 2, t.w, t.h };
+        SDL_RenderCopy(renderer, t.texture, &src, &dst);
+    }
+
+    SDL_RenderSetClipRect(renderer, hadClip ? &prevClip : nullptr);
+    bars.render(renderer, l, st.scrollTrack, st.scrollThumb);
+}
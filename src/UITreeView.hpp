@@ -0,0 +1,121 @@
+#pragma once
+#include "UIElement.hpp"
+#include "UIScrollBars.hpp"
+#include "UITextRowCache.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Tree whose children are fetched the first time their parent is expanded.
+// The expanded part of the tree is kept flattened into one row array:
+// expanding splices the newly visible subtree in after its parent and
+// collapsing erases it again, so drawing and hit testing only ever index
+// that array.
+class UITreeView : public UIElement {
+public:
+    using NodeId = Uint32;
+    static constexpr NodeId Root = 0;             // hidden; its children are the top level
+    static constexpr NodeId InvalidNode = (NodeId)-1;
+
+    struct Child {
+        std::string label;
+        bool hasChildren = false;   // shows an expander; the loader may still return none
+        Uint64 data = 0;
+    };
+    using Loader = std::function<std::vector<Child>(NodeId node)>;
+
+    UITreeView(int x, int y, int w, int h);
+
+    // Replaces the whole tree; the top level is loaded immediately.
+    UITreeView* setLoader(Loader fn);
+    // Push-style alternative to the loader, e.g. after an asynchronous fetch.
+    // Ids below node become invalid.
+    void setChildren(NodeId node, std::vector<Child> children);
+    // Drops node's children; they are fetched again on the next expand.
+    void reload(NodeId node);
+
+    void expand(NodeId node);
+    void collapse(NodeId node);
+    void toggle(NodeId node);
+    bool isExpanded(NodeId node) const;
+
+    const std::string& label(NodeId node) const { return nodes[node].label; }
+    Uint64 data(NodeId node) const { return nodes[node].data; }
+    NodeId parentOf(NodeId node) const { return nodes[node].parent; }
+    int depth(NodeId node) const { return nodes[node].depth; }
+    const std::vector<NodeId>& childrenOf(NodeId node) const { return nodes[node].children; }
+    size_t visibleRowCount() const { return rows.size(); }
+
+    NodeId selected() const { return selectedNode; }
+    // Expands the ancestors if needed.
+    void select(NodeId node, bool scrollIntoView = true);
+    UITreeView* setOnSelectionChanged(std::function<void(NodeId)> cb) { onSelectionChanged = std::move(cb); return this; }
+    // Enter or double-click.
+    UITreeView* setOnActivate(std::function<void(NodeId)> cb) { onActivate = std::move(cb); return this; }
+
+    UITreeView* setFont(TTF_Font* f);
+    UITreeView* setRowHeight(int px);
+    int rowHeight() const;
+    UITreeView* setIndent(int px) { indentPx = std::max(0, px); markDirty(); return this; }
+
+    void handleEvent(const SDL_Event& e) override;
+    void update(float dt) override;
+    bool wantsFrameUpdate() const override { return false; }
+    void render(SDL_Renderer* renderer) override;
+    bool isHovered() const override { return hovered; }
+    bool isFocusable() const override { return true; }
+
+private:
+    struct Node {
+        std::string label;
+        Uint64 data = 0;
+        NodeId parent = InvalidNode;
+        int  depth = -1;
+        bool hasChildren = false;
+        bool loaded = false;
+        bool expanded = false;
+        std::vector<NodeId> children;
+    };
+    std::vector<Node> nodes;
+    std::vector<NodeId> freeNodes;
+    std::vector<NodeId> rows;        // visible nodes in display order
+    Loader loader;
+
+    NodeId selectedNode = InvalidNode;
+    mutable size_t selRow = (size_t)-1;
+    mutable bool selRowValid = true;
+    size_t hoverRow = (size_t)-1;
+
+    TTF_Font* font = nullptr;
+    int rowH = 0;
+    int indentPx = 18;
+    UIScrollBars bars{ false, true };
+    bool focused = false;
+    bool hovered = false;
+
+    std::function<void(NodeId)> onSelectionChanged;
+    std::function<void(NodeId)> onActivate;
+
+    UITextRowCache text;
+    LookStamp seenLook;
+
+    NodeId alloc_(const Child& c, NodeId parent);
+    void freeChildren_(NodeId node);
+    void ensureLoaded_(NodeId node);
+    void appendVisible_(NodeId node, std::vector<NodeId>& out) const;
+    bool isShown_(NodeId node) const;
+    size_t rowOf_(NodeId node) const;
+    size_t subtreeEnd_(size_t row) const;
+    void expandRow_(size_t row);
+    void collapseRow_(size_t row);
+    void rowsChanged_();
+
+    TTF_Font* activeFont_() const;
+    UIScrollBars::Layout layout_() const;
+    int visibleRows_() const;
+    void setScroll_(double y);
+    void scrollToRow_(size_t row);
+    size_t selectedRow_() const;
+    void selectRow_(size_t row);
+};
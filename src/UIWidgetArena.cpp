@@ -0,0 +1,66 @@
+#include "UIWidgetArena.hpp"
+
+namespace {
+constexpr size_t SLOT_ALIGN = alignof(std::max_align_t);
+
+size_t roundUp(size_t n, size_t a) { return (n + a - 1) / a * a; }
+}
+
+// The slot size is fixed by the first allocation: allocate_shared always asks
+// for one control block of the same type, so later requests match. Anything
+// larger goes straight to operator new.
+bool UIWidgetArena::Pool::fits_(size_t bytes) const {
+    return bytes <= slotSize_;
+}
+
+void UIWidgetArena::Pool::addBlock_() {
+    blocks_.emplace_back(new unsigned char[slotSize_ * slotsPerBlock_]);
+    bumpUsed_ = 0;
+}
+
+void* UIWidgetArena::Pool::allocate(size_t bytes) {
+    if (slotSize_ == 0) slotSize_ = roundUp(bytes < sizeof(void*) ? sizeof(void*) : bytes, SLOT_ALIGN);
+    if (!fits_(bytes)) return ::operator new(bytes);
+
+    void* p;
+    if (!blocks_.empty() && bumpUsed_ < slotsPerBlock_) {
+        p = blocks_.back().get() + bumpUsed_++ * slotSize_;
+    } else if (free_) {
+        p = free_;
+        free_ = *static_cast<void**>(free_);
+    } else {
+        addBlock_();
+        p = blocks_.back().get() + bumpUsed_++ * slotSize_;
+    }
+    ++live_;
+    return p;
+}
+
+void UIWidgetArena::Pool::deallocate(void* p, size_t bytes) {
+    if (!p) return;
+    if (!fits_(bytes)) { ::operator delete(p); return; }
+    *static_cast<void**>(p) = free_;
+    free_ = p;
+    if (--live_ == 0 && orphaned_) delete this;
+}
+
+void UIWidgetArena::Pool::orphan() {
+    if (live_ == 0) delete this;
+    else orphaned_ = true;
+}
+
+UIWidgetArena::~UIWidgetArena() {
+    for (Pool* p : pools_) if (p) p->orphan();
+}
+
+size_t UIWidgetArena::liveObjects() const {
+    size_t n = 0;
+    for (const Pool* p : pools_) if (p) n += p->live();
+    return n;
+}
+
+size_t UIWidgetArena::bytesReserved() const {
+    size_t n = 0;
+    for (const Pool* p : pools_) if (p) n += p->bytesReserved();
+    return n;
+}
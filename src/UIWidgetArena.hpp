@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Opt-in pooled storage for widgets. Each widget class gets its own pool of
+// fixed-size slots carved from large blocks, and make<T>() places the object
+// and its shared_ptr control block in one slot, so widgets created in a row
+// sit next to each other in memory. A pool outlives the arena while any of
+// its widgets are alive. Not thread-safe: create and destroy widgets on the
+// UI thread.
+class UIWidgetArena {
+public:
+    class Pool {
+    public:
+        explicit Pool(size_t slotsPerBlock) : slotsPerBlock_(slotsPerBlock ? slotsPerBlock : 1) {}
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        void* allocate(size_t bytes);
+        void  deallocate(void* p, size_t bytes);
+        // Called by the arena; the pool deletes itself once nothing is live.
+        void  orphan();
+
+        size_t live() const { return live_; }
+        size_t capacity() const { return blocks_.size() * slotsPerBlock_; }
+        size_t bytesReserved() const { return capacity() * slotSize_; }
+
+    private:
+        bool fits_(size_t bytes) const;
+        void addBlock_();
+
+        size_t slotSize_ = 0;
+        size_t slotsPerBlock_;
+        size_t bumpUsed_ = 0;
+        size_t live_ = 0;
+        bool   orphaned_ = false;
+        void*  free_ = nullptr;
+        std::vector<std::unique_ptr<unsigned char[]>> blocks_;
+    };
+
+    template<class T>
+    struct Allocator {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned widgets are not pooled");
+        using value_type = T;
+        Pool* pool;
+
+        explicit Allocator(Pool* p) : pool(p) {}
+        template<class U> Allocator(const Allocator<U>& o) : pool(o.pool) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(pool->allocate(n * sizeof(T))); }
+        void deallocate(T* p, size_t n) { pool->deallocate(p, n * sizeof(T)); }
+
+        template<class U> bool operator==(const Allocator<U>& o) const { return pool == o.pool; }
+        template<class U> bool operator!=(const Allocator<U>& o) const { return pool != o.pool; }
+    };
+
+    explicit UIWidgetArena(size_t slotsPerBlock = 256) : slotsPerBlock_(slotsPerBlock) {}
+    ~UIWidgetArena();
+    UIWidgetArena(const UIWidgetArena&) = delete;
+    UIWidgetArena& operator=(const UIWidgetArena&) = delete;
+
+    template<class T, class... Args>
+    std::shared_ptr<T> make(Args&&... args) {
+        return std::allocate_shared<T>(Allocator<T>(poolFor<T>()), std::forward<Args>(args)...);
+    }
+
+    template<class T>
+    Pool* poolFor() {
+        const size_t slot = typeSlot_<T>();
+        if (slot >= pools_.size()) pools_.resize(slot + 1, nullptr);
+        if (!pools_[slot]) pools_[slot] = new Pool(slotsPerBlock_);
+        return pools_[slot];
+    }
+
+    size_t liveObjects() const;
+    size_t bytesReserved() const;
+
+private:
+    template<class T>
+    static size_t typeSlot_() {
+        static const size_t slot = nextTypeSlot_++;
+        return slot;
+    }
+    static inline size_t nextTypeSlot_ = 0;
+
+    size_t slotsPerBlock_;
+    std::vector<Pool*> pools_;
+};
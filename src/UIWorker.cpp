@@ -0,0 +1,53 @@
+#include "UIWorker.hpp"
+
+UIWorker::~UIWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+UIWorker& UIWorker::shared() {
+    static UIWorker worker;
+    return worker;
+}
+
+void UIWorker::post(std::function<void()> job) {
+    if (!job) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+        jobs_.push_back(std::move(job));
+        if (!thread_.joinable()) thread_ = std::thread(&UIWorker::run_, this);
+    }
+    cv_.notify_one();
+}
+
+size_t UIWorker::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+void UIWorker::wakeUI() {
+    SDL_Event ev{};
+    ev.type = SDL_USEREVENT;
+    ev.user.code = WAKE_EVENT;
+    SDL_PushEvent(&ev);
+}
+
+void UIWorker::run_() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Background thread for work the UI thread must not wait on (sorting,
+// decoding). Jobs run one at a time in post order. A job never touches
+// widgets: it publishes its result somewhere the widget polls from
+// update(), then calls wakeUI() so an idle SDL_WaitEvent loop renders.
+class UIWorker {
+public:
+    // SDL_USEREVENT code pushed by wakeUI(); UIManager ignores it.
+    static constexpr Sint32 WAKE_EVENT = 0xF005;
+
+    UIWorker() = default;
+    ~UIWorker();
+    UIWorker(const UIWorker&) = delete;
+    UIWorker& operator=(const UIWorker&) = delete;
+
+    // Process-wide worker, started on first post().
+    static UIWorker& shared();
+
+    void post(std::function<void()> job);
+    size_t pending() const;
+
+    static void wakeUI();
+
+private:
+    void run_();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    std::thread thread_;
+    bool stopping_ = false;
+};